@@ -61,6 +61,22 @@ class protocol_error : public std::runtime_error {
      protocol_error(const std::string& message) : std::runtime_error(message) {};
 };
 
+class timeout_error : public std::runtime_error {
+  public:
+     timeout_error(const std::string& message) : std::runtime_error(message) {};
+};
+
+class wamp_error : public std::runtime_error {
+  public:
+     wamp_error(const std::string& error_uri, const std::string& message)
+         : std::runtime_error(message), m_error_uri(error_uri) {};
+
+     const std::string& error_uri() const { return m_error_uri; };
+
+  private:
+     std::string m_error_uri;
+};
+
 } // namespace autobahn
 
 #endif // AUTOBAHN_EXCEPTIONS_HPP
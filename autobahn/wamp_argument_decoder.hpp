@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_ARGUMENT_DECODER_HPP
+#define AUTOBAHN_WAMP_ARGUMENT_DECODER_HPP
+
+#include "wamp_kw_argument_index.hpp"
+
+#include <msgpack/object.hpp>
+
+#include <cstddef>
+
+/*!
+ * Declares the schema of a struct that events, invocations and call results
+ * can decode their arguments into with decode_arguments(). The fields are
+ * listed without separators, in the order of the positional arguments:
+ *
+ *     struct quote
+ *     {
+ *         std::string symbol;
+ *         double price = 0.0;
+ *         int volume = 0;
+ *
+ *         WAMP_DEFINE_ARGUMENTS(
+ *             WAMP_ARGUMENT(symbol)
+ *             WAMP_KW_ARGUMENT(price)
+ *             WAMP_KW_ARGUMENT(volume))
+ *     };
+ *
+ *     quote q = event->decode_arguments<quote>();
+ *
+ * Instead of using the macros, a struct may define the generated member
+ * template itself and call argument() and kw_argument() on the decoder.
+ */
+#define WAMP_DEFINE_ARGUMENTS(fields) \
+    template <typename Decoder> \
+    void wamp_decode(Decoder& decoder) \
+    { \
+        fields \
+    }
+
+/*!
+ * Decodes the next positional argument into a member.
+ */
+#define WAMP_ARGUMENT(member) decoder.argument(member);
+
+/*!
+ * Decodes the keyword argument named like a member into the member.
+ */
+#define WAMP_KW_ARGUMENT(member) decoder.kw_argument(#member, member);
+
+namespace autobahn {
+
+/*!
+ * Decodes positional and keyword arguments straight into the members of a
+ * struct, in the order in which its schema lists them. The positional
+ * arguments are walked once from front to back, and the keyword arguments
+ * are looked up through an index, so decoding a struct does not scan the
+ * arguments for every member.
+ *
+ * As with kw_argument_or(), a member whose argument is missing keeps the
+ * value it had, which is its default.
+ */
+class wamp_argument_decoder
+{
+public:
+    /*!
+     * Constructs a decoder.
+     *
+     * @param arguments The positional arguments.
+     * @param kw_arguments The keyword arguments.
+     * @param kw_argument_index The index of the keyword arguments.
+     */
+    wamp_argument_decoder(
+            const msgpack::object& arguments,
+            const msgpack::object& kw_arguments,
+            wamp_kw_argument_index& kw_argument_index);
+
+    /*!
+     * Converts the next positional argument into @p value, if there is one.
+     *
+     * @throw std::bad_cast
+     */
+    template <typename T>
+    wamp_argument_decoder& argument(T& value);
+
+    /*!
+     * Converts the keyword argument with the given @p key into @p value,
+     * if there is one.
+     *
+     * @throw std::bad_cast
+     */
+    template <typename T>
+    wamp_argument_decoder& kw_argument(const char* key, T& value);
+
+    /*!
+     * Decodes the arguments into a struct that declares its schema.
+     */
+    template <typename Struct>
+    void decode(Struct& value);
+
+private:
+    const msgpack::object& m_arguments;
+    const msgpack::object& m_kw_arguments;
+    wamp_kw_argument_index& m_kw_argument_index;
+
+    /*!
+     * The index of the next positional argument.
+     */
+    std::size_t m_next_argument;
+};
+
+} // namespace autobahn
+
+#include "wamp_argument_decoder.ipp"
+
+#endif // AUTOBAHN_WAMP_ARGUMENT_DECODER_HPP
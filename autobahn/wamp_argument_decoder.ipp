@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+namespace autobahn {
+
+inline wamp_argument_decoder::wamp_argument_decoder(
+        const msgpack::object& arguments,
+        const msgpack::object& kw_arguments,
+        wamp_kw_argument_index& kw_argument_index)
+    : m_arguments(arguments)
+    , m_kw_arguments(kw_arguments)
+    , m_kw_argument_index(kw_argument_index)
+    , m_next_argument(0)
+{
+}
+
+template <typename T>
+inline wamp_argument_decoder& wamp_argument_decoder::argument(T& value)
+{
+    if (m_arguments.type == msgpack::type::ARRAY && m_next_argument < m_arguments.via.array.size) {
+        m_arguments.via.array.ptr[m_next_argument].convert(value);
+    }
+
+    ++m_next_argument;
+    return *this;
+}
+
+template <typename T>
+inline wamp_argument_decoder& wamp_argument_decoder::kw_argument(const char* key, T& value)
+{
+    const msgpack::object* kw_argument = m_kw_argument_index.find(m_kw_arguments, key, strlen(key));
+    if (kw_argument) {
+        kw_argument->convert(value);
+    }
+    return *this;
+}
+
+template <typename Struct>
+inline void wamp_argument_decoder::decode(Struct& value)
+{
+    value.wamp_decode(*this);
+}
+
+} // namespace autobahn
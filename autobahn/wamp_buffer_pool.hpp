@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_BUFFER_POOL_HPP
+#define AUTOBAHN_WAMP_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <msgpack/sbuffer.hpp>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A free list of send buffers. Buffers are handed back to the pool once
+ * they have been written so that sending a message does not have to
+ * allocate in steady state.
+ *
+ * The pool is not thread safe, it is meant to be used from the io
+ * service that drives a transport.
+ */
+class wamp_buffer_pool
+{
+public:
+    /*!
+     * Constructs a buffer pool.
+     *
+     * @param max_buffers The maximum number of buffers held by the pool.
+     * @param max_buffer_size Buffers that held more than this many octets
+     *        are released instead of being pooled. Together with the
+     *        maximum number of buffers this caps the memory held by the pool.
+     * @param initial_buffer_size The initial capacity of new buffers.
+     */
+    wamp_buffer_pool(
+            std::size_t max_buffers=64,
+            std::size_t max_buffer_size=64 * 1024,
+            std::size_t initial_buffer_size=4 * 1024);
+
+    /*!
+     * Takes an empty buffer from the pool, or allocates a new one if
+     * the pool is empty.
+     */
+    std::shared_ptr<msgpack::sbuffer> acquire();
+
+    /*!
+     * Hands a buffer back to the pool. The buffer is dropped if it is
+     * still referenced elsewhere, if it is too large or if the pool is full.
+     */
+    void release(std::shared_ptr<msgpack::sbuffer>&& buffer);
+
+    /*!
+     * The number of buffers currently held by the pool.
+     */
+    std::size_t size() const;
+
+private:
+    /*!
+     * The buffers that are ready to be reused.
+     */
+    std::vector<std::shared_ptr<msgpack::sbuffer>> m_free_buffers;
+
+    /*!
+     * The maximum number of buffers held by the pool.
+     */
+    std::size_t m_max_buffers;
+
+    /*!
+     * The maximum size of a buffer that is still pooled.
+     */
+    std::size_t m_max_buffer_size;
+
+    /*!
+     * The initial capacity of new buffers.
+     */
+    std::size_t m_initial_buffer_size;
+};
+
+} // namespace autobahn
+
+#include "wamp_buffer_pool.ipp"
+
+#endif // AUTOBAHN_WAMP_BUFFER_POOL_HPP
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_buffer_pool::wamp_buffer_pool(
+        std::size_t max_buffers,
+        std::size_t max_buffer_size,
+        std::size_t initial_buffer_size)
+    : m_free_buffers()
+    , m_max_buffers(max_buffers)
+    , m_max_buffer_size(max_buffer_size)
+    , m_initial_buffer_size(initial_buffer_size)
+{
+    // Reserve up front so that handing buffers back never allocates.
+    m_free_buffers.reserve(max_buffers);
+}
+
+inline std::shared_ptr<msgpack::sbuffer> wamp_buffer_pool::acquire()
+{
+    if (m_free_buffers.empty()) {
+        return std::make_shared<msgpack::sbuffer>(m_initial_buffer_size);
+    }
+
+    std::shared_ptr<msgpack::sbuffer> buffer = std::move(m_free_buffers.back());
+    m_free_buffers.pop_back();
+
+    return buffer;
+}
+
+inline void wamp_buffer_pool::release(std::shared_ptr<msgpack::sbuffer>&& buffer)
+{
+    if (!buffer || buffer.use_count() != 1
+            || buffer->size() > m_max_buffer_size
+            || m_free_buffers.size() >= m_max_buffers) {
+        buffer.reset();
+        return;
+    }
+
+    buffer->clear();
+    m_free_buffers.push_back(std::move(buffer));
+}
+
+inline std::size_t wamp_buffer_pool::size() const
+{
+    return m_free_buffers.size();
+}
+
+} // namespace autobahn
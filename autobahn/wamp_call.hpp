@@ -32,21 +32,71 @@
 #define AUTOBAHN_WAMP_CALL_HPP
 
 #include "wamp_call_result.hpp"
+#include "wamp_message.hpp"
+#include "wamp_timer_wheel.hpp"
 #include "boost_config.hpp"
 
+#include <boost/exception_ptr.hpp>
+
+#include <chrono>
+
 namespace autobahn {
 
 /// An outstanding wamp call.
+///
+/// The session allocates its calls from a slab and keeps the CALL message
+/// in the call until it has been sent, so that starting a call allocates as
+/// little as possible.
 class wamp_call
 {
 public:
-    wamp_call();
+    wamp_call(wamp_message&& message, std::chrono::milliseconds timeout);
+    virtual ~wamp_call();
+
+    virtual void set_result(wamp_call_result&& value) = 0;
+    virtual void set_exception(const boost::exception_ptr& exception) = 0;
+
+    /// Fails the call with the error URI and arguments of an ERROR message,
+    /// which a handler receives along with the error code.
+    virtual void set_error(const boost::exception_ptr& exception, wamp_call_result&& details) = 0;
+
+    /// Pilfers the CALL message.
+    wamp_message&& message();
+
+    /// The time after which the session gives up on the call, or zero.
+    std::chrono::milliseconds timeout() const;
+
+    /// The deadline of the call in the session's timer wheel.
+    wamp_timer_wheel::node& timeout_node();
+
+    /// Whether or not the call has already failed with a timeout, while the
+    /// session still waits for the router to confirm its cancellation.
+    bool timed_out() const;
+    void set_timed_out();
+
+private:
+    wamp_message m_message;
+    std::chrono::milliseconds m_timeout;
+    wamp_timer_wheel::node m_timeout_node;
+    bool m_timed_out;
+};
+
+/// An outstanding wamp call that reports its result through a completion,
+/// either a wamp_promise_completion or a wamp_handler_completion.
+template <typename Completion>
+class wamp_basic_call : public wamp_call
+{
+public:
+    wamp_basic_call(wamp_message&& message, std::chrono::milliseconds timeout, Completion&& completion);
+
+    Completion& completion();
 
-    boost::promise<wamp_call_result>& result();
-    void set_result(wamp_call_result&& value);
+    virtual void set_result(wamp_call_result&& value) override;
+    virtual void set_exception(const boost::exception_ptr& exception) override;
+    virtual void set_error(const boost::exception_ptr& exception, wamp_call_result&& details) override;
 
 private:
-    boost::promise<wamp_call_result> m_result;
+    Completion m_completion;
 };
 
 } // namespace autobahn
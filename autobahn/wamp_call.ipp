@@ -30,19 +30,74 @@
 
 namespace autobahn {
 
-inline wamp_call::wamp_call()
-    : m_result()
+inline wamp_call::wamp_call(wamp_message&& message, std::chrono::milliseconds timeout)
+    : m_message(std::move(message))
+    , m_timeout(timeout)
+    , m_timeout_node()
+    , m_timed_out(false)
 {
 }
 
-inline boost::promise<wamp_call_result>& wamp_call::result()
+inline wamp_call::~wamp_call()
 {
-    return m_result;
 }
 
-inline void wamp_call::set_result(wamp_call_result&& value)
+inline wamp_message&& wamp_call::message()
 {
-    m_result.set_value(std::move(value));
+    return std::move(m_message);
+}
+
+inline std::chrono::milliseconds wamp_call::timeout() const
+{
+    return m_timeout;
+}
+
+inline wamp_timer_wheel::node& wamp_call::timeout_node()
+{
+    return m_timeout_node;
+}
+
+inline bool wamp_call::timed_out() const
+{
+    return m_timed_out;
+}
+
+inline void wamp_call::set_timed_out()
+{
+    m_timed_out = true;
+}
+
+template <typename Completion>
+inline wamp_basic_call<Completion>::wamp_basic_call(
+        wamp_message&& message, std::chrono::milliseconds timeout, Completion&& completion)
+    : wamp_call(std::move(message), timeout)
+    , m_completion(std::move(completion))
+{
+}
+
+template <typename Completion>
+inline Completion& wamp_basic_call<Completion>::completion()
+{
+    return m_completion;
+}
+
+template <typename Completion>
+inline void wamp_basic_call<Completion>::set_result(wamp_call_result&& value)
+{
+    m_completion.set_value(std::move(value));
+}
+
+template <typename Completion>
+inline void wamp_basic_call<Completion>::set_exception(const boost::exception_ptr& exception)
+{
+    m_completion.set_exception(exception);
+}
+
+template <typename Completion>
+inline void wamp_basic_call<Completion>::set_error(
+        const boost::exception_ptr& exception, wamp_call_result&& details)
+{
+    m_completion.set_error(exception, std::move(details));
 }
 
 } // namespace autobahn
@@ -32,6 +32,7 @@
 #define AUTOBAHN_WAMP_CALL_OPTIONS_HPP
 
 #include <chrono>
+#include <string>
 
 namespace autobahn {
 
@@ -47,10 +48,25 @@ public:
 
     const std::chrono::milliseconds& timeout() const;
 
+    /*!
+     * Sets the time after which the call is given up on. The timeout is
+     * passed on to the router, and the session itself fails the call with a
+     * timeout_error, or wamp_errc::timeout, and cancels it if no result has
+     * arrived by then. A timeout of zero waits forever.
+     */
     void set_timeout(const std::chrono::milliseconds& timeout);
 
+    /*!
+     * The options packed as a msgpack map. The packed options are kept
+     * up to date by the setters so that messages can copy them as they are.
+     */
+    const std::string& packed() const;
+
 private:
+    void update_packed();
+
     std::chrono::milliseconds m_timeout;
+    std::string m_packed;
 };
 
 } // namespace autobahn
@@ -36,6 +36,7 @@ namespace autobahn {
 
 inline wamp_call_options::wamp_call_options()
     : m_timeout()
+    , m_packed("\x80", 1) // empty map
 {
 }
 
@@ -47,6 +48,12 @@ inline const std::chrono::milliseconds& wamp_call_options::timeout() const
 inline void wamp_call_options::set_timeout(const std::chrono::milliseconds& timeout)
 {
     m_timeout = timeout;
+    update_packed();
+}
+
+inline const std::string& wamp_call_options::packed() const
+{
+    return m_packed;
 }
 
 } // namespace autobahn
@@ -82,13 +89,16 @@ struct pack<autobahn::wamp_call_options>
             msgpack::packer<Stream>& packer,
             autobahn::wamp_call_options const& options) const
     {
-        std::unordered_map<std::string, unsigned> options_map;
         const auto& timeout = options.timeout();
-        if (timeout.count() > 0) {
-            options_map["timeout"] = timeout.count();
+        if (timeout.count() <= 0) {
+            packer.pack_map(0);
+            return packer;
         }
 
-        packer.pack(options_map);
+        packer.pack_map(1);
+        packer.pack_str(7);
+        packer.pack_str_body("timeout", 7);
+        packer.pack_uint64(static_cast<uint64_t>(timeout.count()));
 
         return packer;
     }
@@ -115,3 +125,14 @@ struct object_with_zone<autobahn::wamp_call_options>
 } // namespace adaptor
 } // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
 } // namespace msgpack
+
+namespace autobahn {
+
+inline void wamp_call_options::update_packed()
+{
+    msgpack::sbuffer buffer(16);
+    msgpack::pack(buffer, *this);
+    m_packed.assign(buffer.data(), buffer.size());
+}
+
+} // namespace autobahn
@@ -31,9 +31,16 @@
 #ifndef AUTOBAHN_WAMP_CALL_RESULT_HPP
 #define AUTOBAHN_WAMP_CALL_RESULT_HPP
 
+#include "wamp_argument_decoder.hpp"
+#include "wamp_kw_argument_index.hpp"
+#include "wamp_raw_payload.hpp"
+
+#include <boost/optional.hpp>
 #include <msgpack/zone.hpp>
 #include <msgpack/object.hpp>
+#include <msgpack/sbuffer.hpp>
 
+#include <memory>
 #include <string>
 
 namespace autobahn {
@@ -121,11 +128,11 @@ public:
      *
      * Overloads are provided for `std::string` and `char*` as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are scanned with key string comparisons, larger maps are looked up through a
+     * hash index that is built on the first lookup. Memory allocation for keys is avoided.
+     * Building the index modifies the result, so although this function is const it must not be
+     * called from several threads at once. Share the result between threads only with external
+     * synchronization, or convert the keyword arguments with kw_arguments<Map>() before sharing them.
      *
      * Example:
      * `std::string id = result.kw_argument<std::string>("id");`
@@ -145,11 +152,11 @@ public:
      *
      * Overloads are provided for `std::string` and `char*` as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are scanned with key string comparisons, larger maps are looked up through a
+     * hash index that is built on the first lookup. Memory allocation for keys is avoided.
+     * Building the index modifies the result, so although this function is const it must not be
+     * called from several threads at once. Share the result between threads only with external
+     * synchronization, or convert the keyword arguments with kw_arguments<Map>() before sharing them.
      *
      * Example:
      * `std::string id = result.kw_argument_or("id", std::string());`
@@ -187,16 +194,61 @@ public:
     template <typename Map>
     void get_kw_arguments(Map& kw_args) const;
 
+    /*!
+     * The positional and keyword arguments of the call result, decoded into a struct
+     * that declares its schema with WAMP_DEFINE_ARGUMENTS. Members whose
+     * argument is missing keep their default value.
+     *
+     * Example:
+     * `auto q = result.decode_arguments<quote>();`
+     *
+     * @throw std::bad_cast
+     */
+    template <typename Struct>
+    Struct decode_arguments() const;
+
+    /*!
+     * Decode the positional and keyword arguments of the call result into the
+     * given struct, which declares its schema with WAMP_DEFINE_ARGUMENTS.
+     *
+     * @throw std::bad_cast
+     */
+    template <typename Struct>
+    void decode_arguments(Struct& value) const;
+
+    /*!
+     * The positional and keyword result arguments in their packed form, to
+     * be passed on to another message as they are. The payload is only
+     * valid for as long as the call result.
+     *
+     * Example:
+     * `invocation->result(call_result.raw_payload());`
+     */
+    wamp_raw_payload raw_payload() const;
+
+    /*!
+     * The error URI the call failed with, or an empty string for a result.
+     * Handlers passed to wamp_session::async_call receive the arguments of
+     * an ERROR message in the call result, next to the error code.
+     */
+    const std::string& error() const;
+
     //
     // functions only called internally by wamp_session
 
     void set_arguments(const msgpack::object& arguments);
     void set_kw_arguments(const msgpack::object& kw_arguments);
+    void set_raw_payload(const wamp_raw_payload& raw_payload);
+    void set_error(const std::string& error);
 
 private:
     msgpack::zone m_zone;
+    std::string m_error;
     msgpack::object m_arguments;
     msgpack::object m_kw_arguments;
+    mutable wamp_kw_argument_index m_kw_argument_index;
+    mutable boost::optional<wamp_raw_payload> m_raw_payload;
+    mutable std::unique_ptr<msgpack::sbuffer> m_raw_payload_buffer;
 };
 
 } // namespace autobahn
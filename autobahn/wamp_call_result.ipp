@@ -37,25 +37,38 @@ namespace autobahn {
 
 inline wamp_call_result::wamp_call_result()
     : m_zone()
+    , m_error()
     , m_arguments(EMPTY_ARGUMENTS)
     , m_kw_arguments(EMPTY_KW_ARGUMENTS)
+    , m_kw_argument_index()
+    , m_raw_payload()
+    , m_raw_payload_buffer()
 {
 }
 
 inline wamp_call_result::wamp_call_result(msgpack::zone&& zone)
     : m_zone(std::move(zone))
+    , m_error()
     , m_arguments(EMPTY_ARGUMENTS)
     , m_kw_arguments(EMPTY_KW_ARGUMENTS)
+    , m_kw_argument_index()
+    , m_raw_payload()
+    , m_raw_payload_buffer()
 {
 }
 
 inline wamp_call_result::wamp_call_result(wamp_call_result&& other)
     : m_zone(std::move(other.m_zone))
+    , m_error(std::move(other.m_error))
     , m_arguments(other.m_arguments)
     , m_kw_arguments(other.m_kw_arguments)
+    , m_kw_argument_index(std::move(other.m_kw_argument_index))
+    , m_raw_payload(other.m_raw_payload)
+    , m_raw_payload_buffer(std::move(other.m_raw_payload_buffer))
 {
     other.m_arguments = EMPTY_ARGUMENTS;
     other.m_kw_arguments = EMPTY_KW_ARGUMENTS;
+    other.m_raw_payload = boost::none;
 }
 
 inline wamp_call_result& wamp_call_result::operator=(wamp_call_result&& other)
@@ -66,10 +79,15 @@ inline wamp_call_result& wamp_call_result::operator=(wamp_call_result&& other)
 
     m_arguments = other.m_arguments;
     m_kw_arguments = other.m_kw_arguments;
+    m_kw_argument_index = std::move(other.m_kw_argument_index);
+    m_raw_payload = other.m_raw_payload;
+    m_raw_payload_buffer = std::move(other.m_raw_payload_buffer);
     m_zone = std::move(other.m_zone);
+    m_error = std::move(other.m_error);
 
     other.m_arguments = EMPTY_ARGUMENTS;
     other.m_kw_arguments = EMPTY_KW_ARGUMENTS;
+    other.m_raw_payload = boost::none;
 
     return *this;
 }
@@ -115,71 +133,35 @@ inline void wamp_call_result::get_each_argument(T&... args) const
 template <typename T>
 inline T wamp_call_result::kw_argument(const std::string& key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
+    const msgpack::object* value = m_kw_argument_index.find(m_kw_arguments, key.data(), key.size());
+    if (!value) {
+        throw std::out_of_range(key + " keyword argument doesn't exist");
     }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw std::out_of_range(key + " keyword argument doesn't exist");
+    return value->as<T>();
 }
 
 template <typename T>
 inline T wamp_call_result::kw_argument(const char* key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
+    const msgpack::object* value = m_kw_argument_index.find(m_kw_arguments, key, strlen(key));
+    if (!value) {
+        throw std::out_of_range(std::string(key) + " keyword argument doesn't exist");
     }
-    throw std::out_of_range(std::string(key) + " keyword argument doesn't exist");
+    return value->as<T>();
 }
 
 template <typename T>
 inline T wamp_call_result::kw_argument_or(const std::string& key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    return fallback;
+    const msgpack::object* value = m_kw_argument_index.find(m_kw_arguments, key.data(), key.size());
+    return value ? value->as<T>() : fallback;
 }
 
 template <typename T>
 inline T wamp_call_result::kw_argument_or(const char* key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw fallback;
+    const msgpack::object* value = m_kw_argument_index.find(m_kw_arguments, key, strlen(key));
+    return value ? value->as<T>() : fallback;
 }
 
 template <typename Map>
@@ -194,6 +176,36 @@ inline void wamp_call_result::get_kw_arguments(Map& kw_args) const
     m_kw_arguments.convert(kw_args);
 }
 
+template <typename Struct>
+inline Struct wamp_call_result::decode_arguments() const
+{
+    Struct value;
+    decode_arguments(value);
+    return value;
+}
+
+template <typename Struct>
+inline void wamp_call_result::decode_arguments(Struct& value) const
+{
+    wamp_argument_decoder decoder(m_arguments, m_kw_arguments, m_kw_argument_index);
+    decoder.decode(value);
+}
+
+inline wamp_raw_payload wamp_call_result::raw_payload() const
+{
+    if (!m_raw_payload) {
+        m_raw_payload_buffer.reset(new msgpack::sbuffer(256));
+        m_raw_payload = pack_wamp_raw_payload(m_arguments, m_kw_arguments, *m_raw_payload_buffer);
+    }
+
+    return *m_raw_payload;
+}
+
+inline const std::string& wamp_call_result::error() const
+{
+    return m_error;
+}
+
 inline void wamp_call_result::set_arguments(const msgpack::object& arguments)
 {
     m_arguments = arguments;
@@ -202,6 +214,17 @@ inline void wamp_call_result::set_arguments(const msgpack::object& arguments)
 inline void wamp_call_result::set_kw_arguments(const msgpack::object& kw_arguments)
 {
     m_kw_arguments = kw_arguments;
+    m_kw_argument_index = wamp_kw_argument_index();
+}
+
+inline void wamp_call_result::set_raw_payload(const wamp_raw_payload& raw_payload)
+{
+    m_raw_payload = raw_payload;
+}
+
+inline void wamp_call_result::set_error(const std::string& error)
+{
+    m_error = error;
 }
 
 } // namespace autobahn
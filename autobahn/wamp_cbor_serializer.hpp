@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_CBOR_SERIALIZER_HPP
+#define AUTOBAHN_WAMP_CBOR_SERIALIZER_HPP
+
+#include "wamp_serializer.hpp"
+
+#include <cstdint>
+#include <msgpack/object.hpp>
+#include <msgpack/zone.hpp>
+
+namespace autobahn {
+
+/*!
+ * Serializes messages as CBOR (RFC 7049).
+ *
+ * Tags are accepted but ignored when deserializing, the tagged item is
+ * used as is. Undefined is treated like null.
+ */
+class wamp_cbor_serializer : public wamp_serializer
+{
+public:
+    /*!
+     * Constructs a CBOR serializer.
+     *
+     * @param max_depth The maximum nesting depth of arrays and maps
+     *        accepted when deserializing.
+     */
+    explicit wamp_cbor_serializer(std::size_t max_depth=64);
+
+    virtual const char* name() const override;
+    virtual const char* subprotocol() const override;
+    virtual wamp_rawsocket_serializer rawsocket_id() const override;
+    virtual bool is_binary() const override;
+
+    virtual void serialize(const wamp_message& message, msgpack::sbuffer& buffer) const override;
+    virtual wamp_message deserialize(const char* data, std::size_t length) const override;
+
+private:
+    class decoder;
+
+    static void write_value(const msgpack::object& value, msgpack::sbuffer& buffer);
+    static void write_header(uint8_t major_type, uint64_t argument, msgpack::sbuffer& buffer);
+
+private:
+    /*!
+     * The maximum nesting depth accepted when deserializing.
+     */
+    std::size_t m_max_depth;
+};
+
+} // namespace autobahn
+
+#include "wamp_cbor_serializer.ipp"
+
+#endif // AUTOBAHN_WAMP_CBOR_SERIALIZER_HPP
@@ -0,0 +1,529 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "exceptions.hpp"
+#include "wamp_message.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A CBOR decoder that builds msgpack objects in a zone.
+ */
+class wamp_cbor_serializer::decoder
+{
+public:
+    decoder(const char* data, std::size_t length, msgpack::zone& zone, std::size_t max_depth)
+        : m_current(data)
+        , m_end(data + length)
+        , m_zone(zone)
+        , m_max_depth(max_depth)
+        , m_scratch()
+    {
+    }
+
+    msgpack::object decode()
+    {
+        msgpack::object value;
+        decode_value(value, 0);
+
+        if (m_current != m_end) {
+            fail("unexpected data after cbor item");
+        }
+
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(const char* reason) const
+    {
+        throw protocol_error(std::string("invalid cbor message: ") + reason);
+    }
+
+    uint8_t read_byte()
+    {
+        if (m_current == m_end) {
+            fail("unexpected end of data");
+        }
+
+        return static_cast<uint8_t>(*m_current++);
+    }
+
+    uint64_t read_uint(std::size_t size)
+    {
+        if (std::size_t(m_end - m_current) < size) {
+            fail("unexpected end of data");
+        }
+
+        uint64_t value = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            value = (value << 8) | static_cast<uint8_t>(*m_current++);
+        }
+
+        return value;
+    }
+
+    uint64_t read_argument(uint8_t info)
+    {
+        if (info < 24) {
+            return info;
+        }
+
+        switch (info) {
+            case 24:
+                return read_uint(1);
+            case 25:
+                return read_uint(2);
+            case 26:
+                return read_uint(4);
+            case 27:
+                return read_uint(8);
+            default:
+                fail("invalid additional information");
+        }
+    }
+
+    /*!
+     * Reads a length and makes sure that the remaining data can hold that
+     * many items before anything gets allocated for them.
+     */
+    std::size_t read_count(uint8_t info, std::size_t min_item_size)
+    {
+        const uint64_t count = read_argument(info);
+        if (count > uint64_t(m_end - m_current) / min_item_size) {
+            fail("length exceeds the message");
+        }
+
+        return static_cast<std::size_t>(count);
+    }
+
+    bool read_break()
+    {
+        if (m_current == m_end) {
+            fail("unexpected end of data");
+        }
+
+        if (static_cast<uint8_t>(*m_current) == 0xFF) {
+            ++m_current;
+            return true;
+        }
+
+        return false;
+    }
+
+    void decode_value(msgpack::object& value, std::size_t depth)
+    {
+        uint8_t initial = read_byte();
+
+        // Tags only annotate the item that follows them.
+        while ((initial >> 5) == 6) {
+            read_argument(initial & 0x1F);
+            initial = read_byte();
+        }
+
+        const uint8_t major_type = initial >> 5;
+        const uint8_t info = initial & 0x1F;
+
+        switch (major_type) {
+            case 0:
+                value.type = msgpack::type::POSITIVE_INTEGER;
+                value.via.u64 = read_argument(info);
+                break;
+            case 1: {
+                const uint64_t argument = read_argument(info);
+                if (argument <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                    value.type = msgpack::type::NEGATIVE_INTEGER;
+                    value.via.i64 = -1 - static_cast<int64_t>(argument);
+                } else {
+                    value.type = msgpack::type::FLOAT64;
+                    value.via.f64 = -1.0 - static_cast<double>(argument);
+                }
+                break;
+            }
+            case 2:
+            case 3:
+                decode_string(major_type, info, value);
+                break;
+            case 4:
+                decode_array(info, value, depth);
+                break;
+            case 5:
+                decode_map(info, value, depth);
+                break;
+            default:
+                decode_simple(info, value);
+                break;
+        }
+    }
+
+    void decode_string(uint8_t major_type, uint8_t info, msgpack::object& value)
+    {
+        const char* data = m_current;
+        std::size_t length = 0;
+
+        if (info == 31) {
+            // Indefinite length strings are a sequence of definite length chunks.
+            m_scratch.clear();
+            while (!read_break()) {
+                const uint8_t initial = read_byte();
+                if ((initial >> 5) != major_type || (initial & 0x1F) == 31) {
+                    fail("invalid string chunk");
+                }
+
+                const std::size_t chunk_length = read_count(initial & 0x1F, 1);
+                m_scratch.append(m_current, chunk_length);
+                m_current += chunk_length;
+            }
+
+            data = m_scratch.data();
+            length = m_scratch.size();
+        } else {
+            length = read_count(info, 1);
+            data = m_current;
+            m_current += length;
+        }
+
+        char* ptr = nullptr;
+        if (length > 0) {
+            ptr = static_cast<char*>(m_zone.allocate_no_align(length));
+            memcpy(ptr, data, length);
+        }
+
+        if (major_type == 2) {
+            value.type = msgpack::type::BIN;
+            value.via.bin.size = static_cast<uint32_t>(length);
+            value.via.bin.ptr = ptr;
+        } else {
+            value.type = msgpack::type::STR;
+            value.via.str.size = static_cast<uint32_t>(length);
+            value.via.str.ptr = ptr;
+        }
+    }
+
+    void decode_array(uint8_t info, msgpack::object& value, std::size_t depth)
+    {
+        if (++depth > m_max_depth) {
+            fail("maximum nesting depth exceeded");
+        }
+
+        msgpack::object* elements = nullptr;
+        std::size_t size = 0;
+
+        if (info == 31) {
+            std::vector<msgpack::object> collected;
+            while (!read_break()) {
+                collected.emplace_back();
+                decode_value(collected.back(), depth);
+            }
+
+            size = collected.size();
+            if (size > 0) {
+                elements = static_cast<msgpack::object*>(
+                        m_zone.allocate_align(sizeof(msgpack::object) * size));
+                std::copy(collected.begin(), collected.end(), elements);
+            }
+        } else {
+            size = read_count(info, 1);
+            if (size > 0) {
+                elements = static_cast<msgpack::object*>(
+                        m_zone.allocate_align(sizeof(msgpack::object) * size));
+                for (std::size_t i = 0; i < size; ++i) {
+                    elements[i] = msgpack::object();
+                    decode_value(elements[i], depth);
+                }
+            }
+        }
+
+        value.type = msgpack::type::ARRAY;
+        value.via.array.size = static_cast<uint32_t>(size);
+        value.via.array.ptr = elements;
+    }
+
+    void decode_map(uint8_t info, msgpack::object& value, std::size_t depth)
+    {
+        if (++depth > m_max_depth) {
+            fail("maximum nesting depth exceeded");
+        }
+
+        msgpack::object_kv* entries = nullptr;
+        std::size_t size = 0;
+
+        if (info == 31) {
+            std::vector<msgpack::object_kv> collected;
+            while (!read_break()) {
+                collected.emplace_back();
+                decode_value(collected.back().key, depth);
+                decode_value(collected.back().val, depth);
+            }
+
+            size = collected.size();
+            if (size > 0) {
+                entries = static_cast<msgpack::object_kv*>(
+                        m_zone.allocate_align(sizeof(msgpack::object_kv) * size));
+                std::copy(collected.begin(), collected.end(), entries);
+            }
+        } else {
+            size = read_count(info, 2);
+            if (size > 0) {
+                entries = static_cast<msgpack::object_kv*>(
+                        m_zone.allocate_align(sizeof(msgpack::object_kv) * size));
+                for (std::size_t i = 0; i < size; ++i) {
+                    entries[i].key = msgpack::object();
+                    entries[i].val = msgpack::object();
+                    decode_value(entries[i].key, depth);
+                    decode_value(entries[i].val, depth);
+                }
+            }
+        }
+
+        value.type = msgpack::type::MAP;
+        value.via.map.size = static_cast<uint32_t>(size);
+        value.via.map.ptr = entries;
+    }
+
+    void decode_simple(uint8_t info, msgpack::object& value)
+    {
+        switch (info) {
+            case 20:
+                value.type = msgpack::type::BOOLEAN;
+                value.via.boolean = false;
+                break;
+            case 21:
+                value.type = msgpack::type::BOOLEAN;
+                value.via.boolean = true;
+                break;
+            case 22:
+            case 23:
+                value.type = msgpack::type::NIL;
+                break;
+            case 25: {
+                const uint16_t half = static_cast<uint16_t>(read_uint(2));
+                const int exponent = (half >> 10) & 0x1F;
+                const int mantissa = half & 0x3FF;
+
+                double result;
+                if (exponent == 0) {
+                    result = std::ldexp(mantissa, -24);
+                } else if (exponent != 31) {
+                    result = std::ldexp(mantissa + 1024, exponent - 25);
+                } else if (mantissa == 0) {
+                    result = std::numeric_limits<double>::infinity();
+                } else {
+                    result = std::numeric_limits<double>::quiet_NaN();
+                }
+
+                value.type = msgpack::type::FLOAT32;
+                value.via.f64 = (half & 0x8000) ? -result : result;
+                break;
+            }
+            case 26: {
+                const uint32_t bits = static_cast<uint32_t>(read_uint(4));
+                float result;
+                memcpy(&result, &bits, sizeof(result));
+
+                value.type = msgpack::type::FLOAT32;
+                value.via.f64 = result;
+                break;
+            }
+            case 27: {
+                const uint64_t bits = read_uint(8);
+                double result;
+                memcpy(&result, &bits, sizeof(result));
+
+                value.type = msgpack::type::FLOAT64;
+                value.via.f64 = result;
+                break;
+            }
+            default:
+                fail("unsupported simple value");
+        }
+    }
+
+private:
+    const char* m_current;
+    const char* m_end;
+    msgpack::zone& m_zone;
+    std::size_t m_max_depth;
+    std::string m_scratch;
+};
+
+inline wamp_cbor_serializer::wamp_cbor_serializer(std::size_t max_depth)
+    : m_max_depth(max_depth)
+{
+}
+
+inline const char* wamp_cbor_serializer::name() const
+{
+    return "cbor";
+}
+
+inline const char* wamp_cbor_serializer::subprotocol() const
+{
+    return "wamp.2.cbor";
+}
+
+inline wamp_rawsocket_serializer wamp_cbor_serializer::rawsocket_id() const
+{
+    return wamp_rawsocket_serializer::cbor;
+}
+
+inline bool wamp_cbor_serializer::is_binary() const
+{
+    return true;
+}
+
+inline void wamp_cbor_serializer::serialize(
+        const wamp_message& message, msgpack::sbuffer& buffer) const
+{
+    write_header(4, message.size(), buffer);
+    for (std::size_t index = 0; index < message.size(); ++index) {
+        write_value(message.field(index), buffer);
+    }
+}
+
+inline wamp_message wamp_cbor_serializer::deserialize(
+        const char* data, std::size_t length) const
+{
+    msgpack::zone zone;
+    decoder cbor_decoder(data, length, zone, m_max_depth);
+
+    msgpack::object array = cbor_decoder.decode();
+    if (array.type != msgpack::type::ARRAY) {
+        throw protocol_error("invalid cbor message: not an array");
+    }
+
+    return wamp_message(array, std::move(zone));
+}
+
+inline void wamp_cbor_serializer::write_value(
+        const msgpack::object& value, msgpack::sbuffer& buffer)
+{
+    switch (value.type) {
+        case msgpack::type::NIL:
+            buffer.write("\xF6", 1);
+            break;
+        case msgpack::type::BOOLEAN:
+            buffer.write(value.via.boolean ? "\xF5" : "\xF4", 1);
+            break;
+        case msgpack::type::POSITIVE_INTEGER:
+            write_header(0, value.via.u64, buffer);
+            break;
+        case msgpack::type::NEGATIVE_INTEGER:
+            write_header(1, static_cast<uint64_t>(-(value.via.i64 + 1)), buffer);
+            break;
+        case msgpack::type::FLOAT32: {
+            const float single = static_cast<float>(value.via.f64);
+            uint32_t bits;
+            memcpy(&bits, &single, sizeof(bits));
+
+            const char bytes[5] = {
+                '\xFA',
+                static_cast<char>(bits >> 24),
+                static_cast<char>(bits >> 16),
+                static_cast<char>(bits >> 8),
+                static_cast<char>(bits)
+            };
+            buffer.write(bytes, sizeof(bytes));
+            break;
+        }
+        case msgpack::type::FLOAT64: {
+            uint64_t bits;
+            memcpy(&bits, &value.via.f64, sizeof(bits));
+
+            char bytes[9];
+            bytes[0] = '\xFB';
+            for (int i = 0; i < 8; ++i) {
+                bytes[1 + i] = static_cast<char>(bits >> (56 - 8 * i));
+            }
+            buffer.write(bytes, sizeof(bytes));
+            break;
+        }
+        case msgpack::type::STR:
+            write_header(3, value.via.str.size, buffer);
+            buffer.write(value.via.str.ptr, value.via.str.size);
+            break;
+        case msgpack::type::BIN:
+            write_header(2, value.via.bin.size, buffer);
+            buffer.write(value.via.bin.ptr, value.via.bin.size);
+            break;
+        case msgpack::type::ARRAY:
+            write_header(4, value.via.array.size, buffer);
+            for (uint32_t i = 0; i < value.via.array.size; ++i) {
+                write_value(value.via.array.ptr[i], buffer);
+            }
+            break;
+        case msgpack::type::MAP:
+            write_header(5, value.via.map.size, buffer);
+            for (uint32_t i = 0; i < value.via.map.size; ++i) {
+                write_value(value.via.map.ptr[i].key, buffer);
+                write_value(value.via.map.ptr[i].val, buffer);
+            }
+            break;
+        default:
+            throw protocol_error("msgpack extension types cannot be serialized as cbor");
+    }
+}
+
+inline void wamp_cbor_serializer::write_header(
+        uint8_t major_type, uint64_t argument, msgpack::sbuffer& buffer)
+{
+    char bytes[9];
+    std::size_t argument_size = 0;
+
+    if (argument < 24) {
+        bytes[0] = static_cast<char>((major_type << 5) | argument);
+    } else if (argument <= 0xFF) {
+        bytes[0] = static_cast<char>((major_type << 5) | 24);
+        argument_size = 1;
+    } else if (argument <= 0xFFFF) {
+        bytes[0] = static_cast<char>((major_type << 5) | 25);
+        argument_size = 2;
+    } else if (argument <= 0xFFFFFFFF) {
+        bytes[0] = static_cast<char>((major_type << 5) | 26);
+        argument_size = 4;
+    } else {
+        bytes[0] = static_cast<char>((major_type << 5) | 27);
+        argument_size = 8;
+    }
+
+    for (std::size_t i = 0; i < argument_size; ++i) {
+        bytes[1 + i] = static_cast<char>(argument >> (8 * (argument_size - 1 - i)));
+    }
+
+    buffer.write(bytes, 1 + argument_size);
+}
+
+} // namespace autobahn
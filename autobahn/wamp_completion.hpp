@@ -0,0 +1,236 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_COMPLETION_HPP
+#define AUTOBAHN_WAMP_COMPLETION_HPP
+
+#include "boost_config.hpp"
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/thread/future.hpp>
+
+#include <exception>
+#include <string>
+#include <type_traits>
+
+namespace autobahn {
+
+/*!
+ * The errors that session operations started with a completion token
+ * complete with. They correspond to the exceptions that the future based
+ * operations fail with.
+ */
+enum class wamp_errc
+{
+    /// The router or the peer answered the request with an ERROR.
+    request_failed = 1,
+
+    /// The peer violated the protocol, or the session is not running.
+    protocol_error,
+
+    /// The session has not joined a realm.
+    no_session,
+
+    /// The session is not attached to a transport.
+    no_transport,
+
+    /// The transport failed.
+    network_error,
+
+    /// The router aborted the session.
+    aborted,
+
+    /// The request did not complete within its timeout.
+    timeout,
+
+    /// The router answered with wamp.error.not_authorized.
+    not_authorized,
+
+    /// The router answered with wamp.error.no_such_procedure.
+    no_such_procedure,
+
+    /// The router answered with wamp.error.procedure_already_exists.
+    procedure_already_exists,
+
+    /// The router or the callee answered with wamp.error.invalid_argument.
+    invalid_argument,
+
+    /// The request was canceled, wamp.error.canceled.
+    canceled
+};
+
+/*!
+ * The error category of wamp_errc.
+ */
+const boost::system::error_category& wamp_category();
+
+boost::system::error_code make_error_code(wamp_errc e);
+
+/*!
+ * The error code corresponding to an exception that a session operation
+ * failed with. A wamp_error with one of the predefined WAMP error URIs maps
+ * to the matching wamp_errc, any other URI to wamp_errc::request_failed.
+ */
+boost::system::error_code make_error_code(const boost::exception_ptr& exception);
+
+/*!
+ * The exception that is being handled, for passing it on to a completion.
+ * Unlike boost::current_exception(), this keeps the type of the exceptions
+ * from exceptions.hpp, so that they can be caught as such from a future.
+ */
+boost::exception_ptr current_wamp_exception();
+
+/*!
+ * Completes a session request by fulfilling a promise, for the operations
+ * that return a boost::future.
+ */
+template <typename T>
+class wamp_promise_completion
+{
+public:
+    wamp_promise_completion();
+
+    boost::future<T> get_future();
+
+    void set_value(T&& value);
+    void set_exception(const boost::exception_ptr& exception);
+
+    /*!
+     * Fails the request while passing details of the error along with the
+     * error code, for handlers. A promise only keeps the exception.
+     */
+    void set_error(const boost::exception_ptr& exception, T&& details);
+
+private:
+    boost::promise<T> m_promise;
+};
+
+/*!
+ * Completes a session request that has no result by fulfilling a promise.
+ */
+template <>
+class wamp_promise_completion<void>
+{
+public:
+    wamp_promise_completion();
+
+    boost::future<void> get_future();
+
+    void set_value();
+    void set_exception(const boost::exception_ptr& exception);
+
+private:
+    boost::promise<void> m_promise;
+};
+
+/*!
+ * Completes a session request by invoking an Asio completion handler with
+ * the signature void(boost::system::error_code, T). The handler is invoked
+ * through its associated executor, which defaults to the executor of the
+ * session's io service, and that executor is kept busy until the request
+ * completes. As with Asio's own operations, a request that is dropped
+ * without completing, because the session went away, destroys its handler
+ * without invoking it.
+ *
+ * Unlike a promise, the completion does not allocate any shared state.
+ */
+template <typename T, typename Handler>
+class wamp_handler_completion
+{
+public:
+    using executor_type = typename boost::asio::associated_executor<
+            Handler, boost::asio::io_service::executor_type>::type;
+
+    wamp_handler_completion(Handler&& handler, boost::asio::io_service& io_service);
+    wamp_handler_completion(wamp_handler_completion&& other);
+
+    wamp_handler_completion(const wamp_handler_completion&) = delete;
+    wamp_handler_completion& operator=(const wamp_handler_completion&) = delete;
+
+    void set_value(T&& value);
+    void set_exception(const boost::exception_ptr& exception);
+
+    /*!
+     * Fails the request while passing details of the error along with the
+     * error code, for handlers. A promise only keeps the exception.
+     */
+    void set_error(const boost::exception_ptr& exception, T&& details);
+
+private:
+    Handler m_handler;
+    boost::asio::executor_work_guard<executor_type> m_work;
+};
+
+/*!
+ * Completes a session request that has no result by invoking an Asio
+ * completion handler with the signature void(boost::system::error_code).
+ */
+template <typename Handler>
+class wamp_handler_completion<void, Handler>
+{
+public:
+    using executor_type = typename boost::asio::associated_executor<
+            Handler, boost::asio::io_service::executor_type>::type;
+
+    wamp_handler_completion(Handler&& handler, boost::asio::io_service& io_service);
+    wamp_handler_completion(wamp_handler_completion&& other);
+
+    wamp_handler_completion(const wamp_handler_completion&) = delete;
+    wamp_handler_completion& operator=(const wamp_handler_completion&) = delete;
+
+    void set_value();
+    void set_exception(const boost::exception_ptr& exception);
+
+private:
+    Handler m_handler;
+    boost::asio::executor_work_guard<executor_type> m_work;
+};
+
+} // namespace autobahn
+
+namespace boost {
+namespace system {
+
+template <>
+struct is_error_code_enum<autobahn::wamp_errc> : std::true_type
+{
+};
+
+} // namespace system
+} // namespace boost
+
+#include "wamp_completion.ipp"
+
+#endif // AUTOBAHN_WAMP_COMPLETION_HPP
@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "exceptions.hpp"
+
+#include <boost/asio/dispatch.hpp>
+
+#include <utility>
+
+namespace autobahn {
+
+namespace detail {
+
+class wamp_error_category : public boost::system::error_category
+{
+public:
+    const char* name() const BOOST_SYSTEM_NOEXCEPT override
+    {
+        return "autobahn.wamp";
+    }
+
+    std::string message(int value) const override
+    {
+        switch (static_cast<wamp_errc>(value)) {
+            case wamp_errc::request_failed:
+                return "request failed";
+            case wamp_errc::protocol_error:
+                return "protocol error";
+            case wamp_errc::no_session:
+                return "session not joined";
+            case wamp_errc::no_transport:
+                return "session not attached";
+            case wamp_errc::network_error:
+                return "network error";
+            case wamp_errc::aborted:
+                return "session aborted";
+            case wamp_errc::timeout:
+                return "request timed out";
+            case wamp_errc::not_authorized:
+                return "not authorized";
+            case wamp_errc::no_such_procedure:
+                return "no such procedure";
+            case wamp_errc::procedure_already_exists:
+                return "procedure already exists";
+            case wamp_errc::invalid_argument:
+                return "invalid argument";
+            case wamp_errc::canceled:
+                return "request canceled";
+        }
+        return "unknown error";
+    }
+};
+
+/*!
+ * Binds the result of a request to its completion handler.
+ */
+template <typename Handler, typename T>
+class wamp_completion_binder
+{
+public:
+    wamp_completion_binder(Handler&& handler, const boost::system::error_code& error, T&& value)
+        : m_handler(std::move(handler))
+        , m_error(error)
+        , m_value(std::move(value))
+    {
+    }
+
+    void operator()()
+    {
+        m_handler(m_error, std::move(m_value));
+    }
+
+private:
+    Handler m_handler;
+    boost::system::error_code m_error;
+    T m_value;
+};
+
+template <typename Handler>
+class wamp_completion_binder<Handler, void>
+{
+public:
+    wamp_completion_binder(Handler&& handler, const boost::system::error_code& error)
+        : m_handler(std::move(handler))
+        , m_error(error)
+    {
+    }
+
+    void operator()()
+    {
+        m_handler(m_error);
+    }
+
+private:
+    Handler m_handler;
+    boost::system::error_code m_error;
+};
+
+} // namespace detail
+
+inline const boost::system::error_category& wamp_category()
+{
+    static detail::wamp_error_category category;
+    return category;
+}
+
+inline boost::system::error_code make_error_code(wamp_errc e)
+{
+    return boost::system::error_code(static_cast<int>(e), wamp_category());
+}
+
+inline boost::system::error_code make_error_code(const boost::exception_ptr& exception)
+{
+    try {
+        boost::rethrow_exception(exception);
+    } catch (const wamp_error& e) {
+        const std::string& uri = e.error_uri();
+        if (uri == "wamp.error.not_authorized") {
+            return make_error_code(wamp_errc::not_authorized);
+        }
+        if (uri == "wamp.error.no_such_procedure") {
+            return make_error_code(wamp_errc::no_such_procedure);
+        }
+        if (uri == "wamp.error.procedure_already_exists") {
+            return make_error_code(wamp_errc::procedure_already_exists);
+        }
+        if (uri == "wamp.error.invalid_argument") {
+            return make_error_code(wamp_errc::invalid_argument);
+        }
+        if (uri == "wamp.error.canceled") {
+            return make_error_code(wamp_errc::canceled);
+        }
+        return make_error_code(wamp_errc::request_failed);
+    } catch (const protocol_error&) {
+        return make_error_code(wamp_errc::protocol_error);
+    } catch (const no_session_error&) {
+        return make_error_code(wamp_errc::no_session);
+    } catch (const no_transport_error&) {
+        return make_error_code(wamp_errc::no_transport);
+    } catch (const network_error&) {
+        return make_error_code(wamp_errc::network_error);
+    } catch (const abort_error&) {
+        return make_error_code(wamp_errc::aborted);
+    } catch (const timeout_error&) {
+        return make_error_code(wamp_errc::timeout);
+    } catch (...) {
+        return make_error_code(wamp_errc::request_failed);
+    }
+}
+
+inline boost::exception_ptr current_wamp_exception()
+{
+    try {
+        throw;
+    } catch (const wamp_error& e) {
+        return boost::copy_exception(e);
+    } catch (const protocol_error& e) {
+        return boost::copy_exception(e);
+    } catch (const no_session_error& e) {
+        return boost::copy_exception(e);
+    } catch (const no_transport_error& e) {
+        return boost::copy_exception(e);
+    } catch (const network_error& e) {
+        return boost::copy_exception(e);
+    } catch (const abort_error& e) {
+        return boost::copy_exception(e);
+    } catch (const timeout_error& e) {
+        return boost::copy_exception(e);
+    } catch (...) {
+        return boost::current_exception();
+    }
+}
+
+template <typename T>
+inline wamp_promise_completion<T>::wamp_promise_completion()
+    : m_promise()
+{
+}
+
+template <typename T>
+inline boost::future<T> wamp_promise_completion<T>::get_future()
+{
+    return m_promise.get_future();
+}
+
+template <typename T>
+inline void wamp_promise_completion<T>::set_value(T&& value)
+{
+    m_promise.set_value(std::move(value));
+}
+
+template <typename T>
+inline void wamp_promise_completion<T>::set_exception(const boost::exception_ptr& exception)
+{
+    m_promise.set_exception(exception);
+}
+
+template <typename T>
+inline void wamp_promise_completion<T>::set_error(const boost::exception_ptr& exception, T&& /*details*/)
+{
+    m_promise.set_exception(exception);
+}
+
+inline wamp_promise_completion<void>::wamp_promise_completion()
+    : m_promise()
+{
+}
+
+inline boost::future<void> wamp_promise_completion<void>::get_future()
+{
+    return m_promise.get_future();
+}
+
+inline void wamp_promise_completion<void>::set_value()
+{
+    m_promise.set_value();
+}
+
+inline void wamp_promise_completion<void>::set_exception(const boost::exception_ptr& exception)
+{
+    m_promise.set_exception(exception);
+}
+
+template <typename T, typename Handler>
+inline wamp_handler_completion<T, Handler>::wamp_handler_completion(
+        Handler&& handler, boost::asio::io_service& io_service)
+    : m_handler(std::move(handler))
+    , m_work(boost::asio::get_associated_executor(m_handler, io_service.get_executor()))
+{
+}
+
+template <typename T, typename Handler>
+inline wamp_handler_completion<T, Handler>::wamp_handler_completion(wamp_handler_completion&& other)
+    : m_handler(std::move(other.m_handler))
+    , m_work(std::move(other.m_work))
+{
+}
+
+template <typename T, typename Handler>
+inline void wamp_handler_completion<T, Handler>::set_value(T&& value)
+{
+    boost::asio::dispatch(m_work.get_executor(), detail::wamp_completion_binder<Handler, T>(
+            std::move(m_handler), boost::system::error_code(), std::move(value)));
+    m_work.reset();
+}
+
+template <typename T, typename Handler>
+inline void wamp_handler_completion<T, Handler>::set_exception(const boost::exception_ptr& exception)
+{
+    set_error(exception, T());
+}
+
+template <typename T, typename Handler>
+inline void wamp_handler_completion<T, Handler>::set_error(const boost::exception_ptr& exception, T&& details)
+{
+    boost::asio::dispatch(m_work.get_executor(), detail::wamp_completion_binder<Handler, T>(
+            std::move(m_handler), make_error_code(exception), std::move(details)));
+    m_work.reset();
+}
+
+template <typename Handler>
+inline wamp_handler_completion<void, Handler>::wamp_handler_completion(
+        Handler&& handler, boost::asio::io_service& io_service)
+    : m_handler(std::move(handler))
+    , m_work(boost::asio::get_associated_executor(m_handler, io_service.get_executor()))
+{
+}
+
+template <typename Handler>
+inline wamp_handler_completion<void, Handler>::wamp_handler_completion(wamp_handler_completion&& other)
+    : m_handler(std::move(other.m_handler))
+    , m_work(std::move(other.m_work))
+{
+}
+
+template <typename Handler>
+inline void wamp_handler_completion<void, Handler>::set_value()
+{
+    boost::asio::dispatch(m_work.get_executor(), detail::wamp_completion_binder<Handler, void>(
+            std::move(m_handler), boost::system::error_code()));
+    m_work.reset();
+}
+
+template <typename Handler>
+inline void wamp_handler_completion<void, Handler>::set_exception(const boost::exception_ptr& exception)
+{
+    boost::asio::dispatch(m_work.get_executor(), detail::wamp_completion_binder<Handler, void>(
+            std::move(m_handler), make_error_code(exception)));
+    m_work.reset();
+}
+
+} // namespace autobahn
@@ -32,19 +32,32 @@
 #define AUTOBAHN_WAMP_EVENT_HPP
 
 #include "wamp_arguments.hpp"
+#include "wamp_argument_decoder.hpp"
+#include "wamp_kw_argument_index.hpp"
+#include "wamp_message.hpp"
+#include "wamp_raw_payload.hpp"
 
+#include <boost/optional.hpp>
 #include <msgpack/zone.hpp>
 #include <msgpack/object.hpp>
+#include <msgpack/sbuffer.hpp>
 
 #include <memory>
 #include <string>
 
 namespace autobahn {
 
+/*!
+ * An event received for a subscription. The event keeps the EVENT message
+ * it was received in and only unpacks the details and arguments once they
+ * are accessed, so handlers that ignore parts of the event do not pay for
+ * decoding them. Accessing an event from multiple threads at once is not
+ * supported.
+ */
 class wamp_event_impl
 {
 public:
-    wamp_event_impl(msgpack::zone&& zone);
+    wamp_event_impl(wamp_message&& message);
 
 
     //add URI and details
@@ -124,11 +137,11 @@ public:
      *
      * Overloads are provided for `std::string` and `char*` as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are scanned with key string comparisons, larger maps are looked up through a
+     * hash index that is built on the first lookup. Memory allocation for keys is avoided.
+     * Building the index modifies the event, so although this function is const it must not be
+     * called from several threads at once. Share the event between threads only with external
+     * synchronization, or convert the keyword arguments with kw_arguments<Map>() before sharing them.
      *
      * Example:
      * `std::string id = event.kw_argument<std::string>("id");`
@@ -148,11 +161,11 @@ public:
      *
      * Overloads are provided for `std::string` and `char*` as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are scanned with key string comparisons, larger maps are looked up through a
+     * hash index that is built on the first lookup. Memory allocation for keys is avoided.
+     * Building the index modifies the event, so although this function is const it must not be
+     * called from several threads at once. Share the event between threads only with external
+     * synchronization, or convert the keyword arguments with kw_arguments<Map>() before sharing them.
      *
      * Example:
      * `std::string id = event.kw_argument_or("id", std::string());`
@@ -190,19 +203,68 @@ public:
     template <typename Map>
     void get_kw_arguments(Map& kw_args) const;
 
-    //
-    // functions only called internally by wamp_session
+    /*!
+     * The positional and keyword arguments published by the event, decoded into a struct
+     * that declares its schema with WAMP_DEFINE_ARGUMENTS. Members whose
+     * argument is missing keep their default value.
+     *
+     * Example:
+     * `auto q = event->decode_arguments<quote>();`
+     *
+     * @throw std::bad_cast
+     */
+    template <typename Struct>
+    Struct decode_arguments() const;
+
+    /*!
+     * Decode the positional and keyword arguments published by the event into the
+     * given struct, which declares its schema with WAMP_DEFINE_ARGUMENTS.
+     *
+     * @throw std::bad_cast
+     */
+    template <typename Struct>
+    void decode_arguments(Struct& value) const;
+
+    /*!
+     * The positional and keyword arguments published by the event in their
+     * packed form, to be passed on to another message as they are. The
+     * payload is only valid for as long as the event.
+     *
+     * Example:
+     * `other_session->publish(event->uri(), event->raw_payload());`
+     */
+    wamp_raw_payload raw_payload() const;
 
-    void set_arguments(const msgpack::object& arguments);
-    void set_kw_arguments(const msgpack::object& kw_arguments);
-    void set_details(const msgpack::object& details);
+private:
+    const msgpack::object& arguments_object() const;
+    const msgpack::object& kw_arguments_object() const;
 
 private:
-    msgpack::zone m_zone;
-    msgpack::object m_arguments;
-    msgpack::object m_kw_arguments;
-    std::string m_uri;
+    /*!
+     * The EVENT message, which has been validated by the session.
+     */
+    wamp_message m_message;
 
+    /*!
+     * The topic from the event details, only valid once it has been decoded.
+     */
+    mutable std::string m_uri;
+    mutable bool m_uri_decoded;
+
+    /*!
+     * The packed arguments, once they have been requested.
+     */
+    mutable boost::optional<wamp_raw_payload> m_raw_payload;
+
+    /*!
+     * Holds the packed arguments if the event was not received packed.
+     */
+    mutable std::unique_ptr<msgpack::sbuffer> m_raw_payload_buffer;
+
+    /*!
+     * Speeds up reading many keyword arguments from a large map.
+     */
+    mutable wamp_kw_argument_index m_kw_argument_index;
 };
 
 using wamp_event = std::shared_ptr<wamp_event_impl>;
@@ -34,151 +34,160 @@
 
 namespace autobahn {
 
-inline wamp_event_impl::wamp_event_impl(msgpack::zone&& zone)
-    : m_zone(std::move(zone))
-    , m_arguments(EMPTY_ARGUMENTS)
-    , m_kw_arguments(EMPTY_KW_ARGUMENTS)
+// [EVENT, SUBSCRIBED.Subscription|id, PUBLISHED.Publication|id, Details|dict, PUBLISH.Arguments|list, PUBLISH.ArgumentsKw|dict]
+static const std::size_t EVENT_DETAILS_FIELD = 3;
+static const std::size_t EVENT_ARGUMENTS_FIELD = 4;
+static const std::size_t EVENT_KW_ARGUMENTS_FIELD = 5;
+
+inline wamp_event_impl::wamp_event_impl(wamp_message&& message)
+    : m_message(std::move(message))
+    , m_uri()
+    , m_uri_decoded(false)
+    , m_raw_payload()
+    , m_raw_payload_buffer()
+    , m_kw_argument_index()
 {
 }
 
 inline const std::string& wamp_event_impl::uri() const
 {
+    if (!m_uri_decoded) {
+        m_uri = value_for_key_or<std::string>(
+                m_message.field(EVENT_DETAILS_FIELD), "topic", std::string());
+        m_uri_decoded = true;
+    }
     return m_uri;
 }
 
 inline std::size_t wamp_event_impl::number_of_arguments() const
 {
-    return m_arguments.type == msgpack::type::ARRAY ? m_arguments.via.array.size : 0;
+    const msgpack::object& arguments = arguments_object();
+    return arguments.type == msgpack::type::ARRAY ? arguments.via.array.size : 0;
 }
 
 inline std::size_t wamp_event_impl::number_of_kw_arguments() const
 {
-    return m_kw_arguments.type == msgpack::type::MAP ? m_kw_arguments.via.map.size : 0;
+    const msgpack::object& kw_arguments = kw_arguments_object();
+    return kw_arguments.type == msgpack::type::MAP ? kw_arguments.via.map.size : 0;
 }
 
 template <typename T>
 inline T wamp_event_impl::argument(std::size_t index) const
 {
-    if (m_arguments.type != msgpack::type::ARRAY || m_arguments.via.array.size <= index) {
+    const msgpack::object& arguments = arguments_object();
+    if (arguments.type != msgpack::type::ARRAY || arguments.via.array.size <= index) {
         throw std::out_of_range("no argument at index " + boost::lexical_cast<std::string>(index));
     }
-    return m_arguments.via.array.ptr[index].as<T>();
+    return arguments.via.array.ptr[index].as<T>();
 }
 
 template <typename List>
 inline List wamp_event_impl::arguments() const
 {
-    return m_arguments.as<List>();
+    return arguments_object().as<List>();
 }
 
 template <typename List>
 inline void wamp_event_impl::get_arguments(List& args) const
 {
-    m_arguments.convert(args);
+    arguments_object().convert(args);
 }
 
 template <typename... T>
 inline void wamp_event_impl::get_each_argument(T&... args) const
 {
     auto args_tuple = std::make_tuple(std::ref(args)...);
-    m_arguments.convert(args_tuple);
+    arguments_object().convert(args_tuple);
 }
 
 template <typename T>
 inline T wamp_event_impl::kw_argument(const std::string& key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
+    const msgpack::object* value = m_kw_argument_index.find(kw_arguments_object(), key.data(), key.size());
+    if (!value) {
+        throw std::out_of_range(key + " keyword argument doesn't exist");
     }
-    throw std::out_of_range(key + " keyword argument doesn't exist");
+    return value->as<T>();
 }
 
 template <typename T>
 inline T wamp_event_impl::kw_argument(const char* key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
+    const msgpack::object* value = m_kw_argument_index.find(kw_arguments_object(), key, strlen(key));
+    if (!value) {
+        throw std::out_of_range(std::string(key) + " keyword argument doesn't exist");
     }
-    throw std::out_of_range(std::string(key) + " keyword argument doesn't exist");
+    return value->as<T>();
 }
 
 template <typename T>
 inline T wamp_event_impl::kw_argument_or(const std::string& key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    return fallback;
+    const msgpack::object* value = m_kw_argument_index.find(kw_arguments_object(), key.data(), key.size());
+    return value ? value->as<T>() : fallback;
 }
 
 template <typename T>
 inline T wamp_event_impl::kw_argument_or(const char* key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw fallback;
+    const msgpack::object* value = m_kw_argument_index.find(kw_arguments_object(), key, strlen(key));
+    return value ? value->as<T>() : fallback;
 }
 
 template <typename Map>
 inline Map wamp_event_impl::kw_arguments() const
 {
-    return m_kw_arguments.as<Map>();
+    return kw_arguments_object().as<Map>();
 }
 
 template <typename Map>
 inline void wamp_event_impl::get_kw_arguments(Map& kw_args) const
 {
-    m_kw_arguments.convert(kw_args);
+    kw_arguments_object().convert(kw_args);
+}
+
+template <typename Struct>
+inline Struct wamp_event_impl::decode_arguments() const
+{
+    Struct value;
+    decode_arguments(value);
+    return value;
+}
+
+template <typename Struct>
+inline void wamp_event_impl::decode_arguments(Struct& value) const
+{
+    wamp_argument_decoder decoder(arguments_object(), kw_arguments_object(), m_kw_argument_index);
+    decoder.decode(value);
 }
 
-inline void wamp_event_impl::set_arguments(const msgpack::object& arguments)
+inline wamp_raw_payload wamp_event_impl::raw_payload() const
 {
-    m_arguments = arguments;
+    if (!m_raw_payload) {
+        const char* data = nullptr;
+        std::size_t size = 0;
+        if (m_message.packed_fields(EVENT_ARGUMENTS_FIELD, data, size)) {
+            m_raw_payload = wamp_raw_payload(data, size, m_message.size() - EVENT_ARGUMENTS_FIELD);
+        } else {
+            m_raw_payload_buffer.reset(new msgpack::sbuffer(256));
+            m_raw_payload = pack_wamp_raw_payload(
+                    arguments_object(), kw_arguments_object(), *m_raw_payload_buffer);
+        }
+    }
+
+    return *m_raw_payload;
 }
 
-inline void wamp_event_impl::set_kw_arguments(const msgpack::object& kw_arguments)
+inline const msgpack::object& wamp_event_impl::arguments_object() const
 {
-    m_kw_arguments = kw_arguments;
+    return m_message.size() > EVENT_ARGUMENTS_FIELD
+            ? m_message.field(EVENT_ARGUMENTS_FIELD) : EMPTY_ARGUMENTS;
 }
 
-inline void wamp_event_impl::set_details(const msgpack::object& details)
+inline const msgpack::object& wamp_event_impl::kw_arguments_object() const
 {
-    m_uri = value_for_key_or<std::string>(details, "topic", std::string());
+    return m_message.size() > EVENT_KW_ARGUMENTS_FIELD
+            ? m_message.field(EVENT_KW_ARGUMENTS_FIELD) : EMPTY_KW_ARGUMENTS;
 }
 
 } // namespace autobahn
@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_ID_MAP_HPP
+#define AUTOBAHN_WAMP_ID_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A flat hash map from WAMP ids to values, used by the session to look up
+ * pending requests, subscriptions and registrations. The entries live in a
+ * single array with open addressing and linear probing, so that inserting
+ * an entry does not allocate a node and a lookup touches one or two cache
+ * lines. Erasing shifts the following entries back instead of leaving
+ * tombstones, which keeps lookups short when ids come and go at a high
+ * rate.
+ *
+ * WAMP ids are never zero, which marks an empty slot. Inserting, erasing
+ * or growing the map invalidates pointers to its values.
+ *
+ * @tparam T The value type, which must be default constructible and
+ *           move assignable.
+ */
+template <typename T>
+class wamp_id_map
+{
+public:
+    /*!
+     * Constructs an empty map, which does not allocate until the first
+     * insertion.
+     */
+    wamp_id_map();
+
+    /*!
+     * Finds the value for an id.
+     *
+     * @return The value, or nullptr if the map does not hold the id.
+     */
+    T* find(uint64_t id);
+    const T* find(uint64_t id) const;
+
+    /*!
+     * Inserts a value for an id unless the map already holds the id.
+     *
+     * @return Whether the value has been inserted.
+     */
+    template <typename Value>
+    bool emplace(uint64_t id, Value&& value);
+
+    /*!
+     * The value for an id, which is default constructed and inserted if
+     * the map does not hold the id yet.
+     */
+    T& operator[](uint64_t id);
+
+    /*!
+     * Removes an id and destroys its value.
+     *
+     * @return Whether the map held the id.
+     */
+    bool erase(uint64_t id);
+
+    /*!
+     * Removes an id and moves its value out.
+     *
+     * @return Whether the map held the id.
+     */
+    bool extract(uint64_t id, T& value);
+
+    /*!
+     * The number of ids in the map.
+     */
+    std::size_t size() const;
+
+    bool empty() const;
+
+    /*!
+     * Removes all ids but keeps the slots allocated.
+     */
+    void clear();
+
+    /*!
+     * Exchanges the contents with another map.
+     */
+    void swap(wamp_id_map& other);
+
+    /*!
+     * Calls a function with the id and the value of every entry, in no
+     * particular order. The function must not modify the map.
+     */
+    template <typename Function>
+    void for_each(Function function);
+
+private:
+    struct slot
+    {
+        uint64_t id;
+        T value;
+    };
+
+    /*!
+     * The slot at which the probe sequence of an id starts. Sequential
+     * request ids are spread over the table by Fibonacci hashing.
+     */
+    std::size_t home_slot(uint64_t id) const;
+
+    /*!
+     * The slot holding an id, or the empty slot where it would go.
+     */
+    std::size_t find_slot(uint64_t id) const;
+
+    /*!
+     * Frees a slot and shifts back the entries that had to skip it.
+     */
+    void erase_slot(std::size_t index);
+
+    /*!
+     * Doubles the number of slots once the map is half full.
+     */
+    void reserve_one();
+
+    std::vector<slot> m_slots;
+    std::size_t m_size;
+};
+
+} // namespace autobahn
+
+#include "wamp_id_map.ipp"
+
+#endif // AUTOBAHN_WAMP_ID_MAP_HPP
@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <utility>
+
+namespace autobahn {
+
+template <typename T>
+inline wamp_id_map<T>::wamp_id_map()
+    : m_slots()
+    , m_size(0)
+{
+}
+
+template <typename T>
+inline T* wamp_id_map<T>::find(uint64_t id)
+{
+    if (m_size == 0) {
+        return nullptr;
+    }
+
+    slot& found = m_slots[find_slot(id)];
+    return found.id == id ? &found.value : nullptr;
+}
+
+template <typename T>
+inline const T* wamp_id_map<T>::find(uint64_t id) const
+{
+    if (m_size == 0) {
+        return nullptr;
+    }
+
+    const slot& found = m_slots[find_slot(id)];
+    return found.id == id ? &found.value : nullptr;
+}
+
+template <typename T>
+template <typename Value>
+inline bool wamp_id_map<T>::emplace(uint64_t id, Value&& value)
+{
+    reserve_one();
+
+    slot& found = m_slots[find_slot(id)];
+    if (found.id == id) {
+        return false;
+    }
+
+    found.id = id;
+    found.value = std::forward<Value>(value);
+    ++m_size;
+    return true;
+}
+
+template <typename T>
+inline T& wamp_id_map<T>::operator[](uint64_t id)
+{
+    reserve_one();
+
+    slot& found = m_slots[find_slot(id)];
+    if (found.id != id) {
+        found.id = id;
+        ++m_size;
+    }
+    return found.value;
+}
+
+template <typename T>
+inline bool wamp_id_map<T>::erase(uint64_t id)
+{
+    if (m_size == 0) {
+        return false;
+    }
+
+    const std::size_t index = find_slot(id);
+    if (m_slots[index].id != id) {
+        return false;
+    }
+
+    erase_slot(index);
+    return true;
+}
+
+template <typename T>
+inline bool wamp_id_map<T>::extract(uint64_t id, T& value)
+{
+    if (m_size == 0) {
+        return false;
+    }
+
+    const std::size_t index = find_slot(id);
+    if (m_slots[index].id != id) {
+        return false;
+    }
+
+    value = std::move(m_slots[index].value);
+    erase_slot(index);
+    return true;
+}
+
+template <typename T>
+inline std::size_t wamp_id_map<T>::size() const
+{
+    return m_size;
+}
+
+template <typename T>
+inline bool wamp_id_map<T>::empty() const
+{
+    return m_size == 0;
+}
+
+template <typename T>
+inline void wamp_id_map<T>::clear()
+{
+    for (slot& s : m_slots) {
+        s.id = 0;
+        s.value = T();
+    }
+    m_size = 0;
+}
+
+template <typename T>
+inline void wamp_id_map<T>::swap(wamp_id_map& other)
+{
+    m_slots.swap(other.m_slots);
+    std::swap(m_size, other.m_size);
+}
+
+template <typename T>
+template <typename Function>
+inline void wamp_id_map<T>::for_each(Function function)
+{
+    for (slot& s : m_slots) {
+        if (s.id != 0) {
+            function(s.id, s.value);
+        }
+    }
+}
+
+template <typename T>
+inline std::size_t wamp_id_map<T>::home_slot(uint64_t id) const
+{
+    return static_cast<std::size_t>(id * UINT64_C(0x9e3779b97f4a7c15) >> 32) & (m_slots.size() - 1);
+}
+
+template <typename T>
+inline std::size_t wamp_id_map<T>::find_slot(uint64_t id) const
+{
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t index = home_slot(id);
+    while (m_slots[index].id != 0 && m_slots[index].id != id) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+template <typename T>
+inline void wamp_id_map<T>::erase_slot(std::size_t index)
+{
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t hole = index;
+    std::size_t next = (hole + 1) & mask;
+    while (m_slots[next].id != 0) {
+        // An entry may fill the hole unless its probe sequence starts
+        // cyclically after the hole and at or before its current slot.
+        const std::size_t home = home_slot(m_slots[next].id);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            m_slots[hole].id = m_slots[next].id;
+            m_slots[hole].value = std::move(m_slots[next].value);
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    m_slots[hole].id = 0;
+    m_slots[hole].value = T();
+    --m_size;
+}
+
+template <typename T>
+inline void wamp_id_map<T>::reserve_one()
+{
+    if (2 * (m_size + 1) <= m_slots.size()) {
+        return;
+    }
+
+    std::vector<slot> slots(m_slots.empty() ? 16 : 2 * m_slots.size());
+    for (slot& s : slots) {
+        s.id = 0;
+    }
+    slots.swap(m_slots);
+
+    for (slot& s : slots) {
+        if (s.id != 0) {
+            slot& target = m_slots[find_slot(s.id)];
+            target.id = s.id;
+            target.value = std::move(s.value);
+        }
+    }
+}
+
+} // namespace autobahn
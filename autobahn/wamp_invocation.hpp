@@ -32,9 +32,15 @@
 #define AUTOBAHN_WAMP_INVOCATION_HPP
 
 #include "wamp_arguments.hpp"
+#include "wamp_argument_decoder.hpp"
+#include "wamp_kw_argument_index.hpp"
+#include "wamp_raw_payload.hpp"
+#include "wamp_zone_pool.hpp"
 
+#include <boost/optional.hpp>
 #include <msgpack/zone.hpp>
 #include <msgpack/object.hpp>
+#include <msgpack/sbuffer.hpp>
 
 #include <cstdint>
 #include <functional>
@@ -129,11 +135,11 @@ public:
      *
      * Overloads are provided for `std::string` and `char*` as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are scanned with key string comparisons, larger maps are looked up through a
+     * hash index that is built on the first lookup. Memory allocation for keys is avoided.
+     * Building the index modifies the invocation, so although this function is const it must not be
+     * called from several threads at once. Share the invocation between threads only with external
+     * synchronization, or convert the keyword arguments with kw_arguments<Map>() before sharing them.
      *
      * Example:
      * `std::string id = invocation->kw_argument<std::string>("id");`
@@ -153,11 +159,11 @@ public:
      *
      * Overloads are provided for `std::string` and `char*` as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are scanned with key string comparisons, larger maps are looked up through a
+     * hash index that is built on the first lookup. Memory allocation for keys is avoided.
+     * Building the index modifies the invocation, so although this function is const it must not be
+     * called from several threads at once. Share the invocation between threads only with external
+     * synchronization, or convert the keyword arguments with kw_arguments<Map>() before sharing them.
      *
      * Example:
      * `std::string id = invocation->kw_argument_or("id", std::string());`
@@ -195,6 +201,28 @@ public:
     template <typename Map>
     void get_kw_arguments(Map& kw_args) const;
 
+    /*!
+     * The positional and keyword arguments of the invocation, decoded into a struct
+     * that declares its schema with WAMP_DEFINE_ARGUMENTS. Members whose
+     * argument is missing keep their default value.
+     *
+     * Example:
+     * `auto q = invocation->decode_arguments<quote>();`
+     *
+     * @throw std::bad_cast
+     */
+    template <typename Struct>
+    Struct decode_arguments() const;
+
+    /*!
+     * Decode the positional and keyword arguments of the invocation into the
+     * given struct, which declares its schema with WAMP_DEFINE_ARGUMENTS.
+     *
+     * @throw std::bad_cast
+     */
+    template <typename Struct>
+    void decode_arguments(Struct& value) const;
+
     /*!
     * The call detail passed to the invocation with the given @p key, converted to type T.
     *
@@ -299,6 +327,27 @@ public:
     template <typename List, typename Map>
     void result(const List& arguments, const Map& kw_arguments);
 
+    /*!
+     * The positional and keyword arguments of the invocation in their packed
+     * form, to be passed on to another message as they are. The payload is
+     * only valid for as long as the invocation.
+     *
+     * Example:
+     * `other_session->call(invocation->uri(), invocation->raw_payload());`
+     */
+    wamp_raw_payload raw_payload() const;
+
+    /*!
+     * Send progressive/partial result with already packed arguments.
+     */
+    void progress(const wamp_raw_payload& payload);
+
+    /*!
+     * Reply to the invocation with already packed arguments, for instance
+     * the raw payload of a call result that is being forwarded.
+     */
+    void result(const wamp_raw_payload& payload);
+
     /*!
      * Reply to the invocation with an error and no further details.
      */
@@ -331,29 +380,40 @@ public:
     void set_details(const msgpack::object& details);
     void set_request_id(std::uint64_t);
     void set_zone(msgpack::zone&&);
+    void set_zone_pool(const std::shared_ptr<wamp_zone_pool>& zone_pool);
     void set_arguments(const msgpack::object& arguments);
     void set_kw_arguments(const msgpack::object& kw_arguments);
+    void set_raw_payload(const wamp_raw_payload& raw_payload);
     bool sendable() const;
 
 private:
     void throw_if_not_sendable() const;
 
+    void send_result(const wamp_raw_payload& payload, result_type resultType);
+
     template <typename List>
     void send_result(const List& arguments, result_type resultType);
 
     template <typename List, typename Map>
     void send_result(const List& arguments, const Map& kw_arguments, result_type resultType);
+
+    template <typename... Fields>
+    wamp_message encode_message(const Fields&... fields) const;
 private:
 
 
     msgpack::zone m_zone;
     msgpack::object m_arguments;
     msgpack::object m_kw_arguments;
+    mutable wamp_kw_argument_index m_kw_argument_index;
     msgpack::object m_details;
     send_result_fn m_send_result_fn;
+    std::shared_ptr<wamp_zone_pool> m_zone_pool;
     std::uint64_t m_request_id;
     std::string m_uri;
     bool m_progressive_results_expected;
+    mutable boost::optional<wamp_raw_payload> m_raw_payload;
+    mutable std::unique_ptr<msgpack::sbuffer> m_raw_payload_buffer;
 };
 
 using wamp_invocation = std::shared_ptr<wamp_invocation_impl>;
@@ -29,6 +29,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "wamp_message.hpp"
+#include "wamp_message_encoder.hpp"
 #include "wamp_message_type.hpp"
 
 #include <boost/lexical_cast.hpp>
@@ -41,9 +42,13 @@ inline wamp_invocation_impl::wamp_invocation_impl()
     : m_zone()
     , m_arguments(EMPTY_ARGUMENTS)
     , m_kw_arguments(EMPTY_KW_ARGUMENTS)
+    , m_kw_argument_index()
     , m_send_result_fn()
+    , m_zone_pool()
     , m_request_id(0)
     , m_progressive_results_expected(false)
+    , m_raw_payload()
+    , m_raw_payload_buffer()
 {
 }
 
@@ -100,71 +105,35 @@ inline void wamp_invocation_impl::get_each_argument(T&... args) const
 template <typename T>
 inline T wamp_invocation_impl::kw_argument(const std::string& key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
+    const msgpack::object* value = m_kw_argument_index.find(m_kw_arguments, key.data(), key.size());
+    if (!value) {
+        throw std::out_of_range(key + " keyword argument doesn't exist");
     }
-    throw std::out_of_range(key + " keyword argument doesn't exist");
+    return value->as<T>();
 }
 
 template <typename T>
 inline T wamp_invocation_impl::kw_argument(const char* key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
+    const msgpack::object* value = m_kw_argument_index.find(m_kw_arguments, key, strlen(key));
+    if (!value) {
+        throw std::out_of_range(std::string(key) + " keyword argument doesn't exist");
     }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw std::out_of_range(std::string(key) + " keyword argument doesn't exist");
+    return value->as<T>();
 }
 
 template <typename T>
 inline T wamp_invocation_impl::kw_argument_or(const std::string& key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    return fallback;
+    const msgpack::object* value = m_kw_argument_index.find(m_kw_arguments, key.data(), key.size());
+    return value ? value->as<T>() : fallback;
 }
 
 template <typename T>
 inline T wamp_invocation_impl::kw_argument_or(const char* key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    return fallback;
+    const msgpack::object* value = m_kw_argument_index.find(m_kw_arguments, key, strlen(key));
+    return value ? value->as<T>() : fallback;
 }
 
 
@@ -180,6 +149,21 @@ inline void wamp_invocation_impl::get_kw_arguments(Map& kw_args) const
     m_kw_arguments.convert(kw_args);
 }
 
+template <typename Struct>
+inline Struct wamp_invocation_impl::decode_arguments() const
+{
+    Struct value;
+    decode_arguments(value);
+    return value;
+}
+
+template <typename Struct>
+inline void wamp_invocation_impl::decode_arguments(Struct& value) const
+{
+    wamp_argument_decoder decoder(m_arguments, m_kw_arguments, m_kw_argument_index);
+    decoder.decode(value);
+}
+
 template <typename T>
 inline T wamp_invocation_impl::detail(const std::string& key) const
 {
@@ -371,6 +355,71 @@ inline void wamp_invocation_impl::result(const List& arguments, const Map& kw_ar
     send_result<List, Map>(arguments, kw_arguments, final);
 }
 
+inline wamp_raw_payload wamp_invocation_impl::raw_payload() const
+{
+    if (!m_raw_payload) {
+        m_raw_payload_buffer.reset(new msgpack::sbuffer(256));
+        m_raw_payload = pack_wamp_raw_payload(m_arguments, m_kw_arguments, *m_raw_payload_buffer);
+    }
+
+    return *m_raw_payload;
+}
+
+inline void wamp_invocation_impl::progress(const wamp_raw_payload& payload)
+{
+    send_result(payload, intermediary);
+}
+
+inline void wamp_invocation_impl::result(const wamp_raw_payload& payload)
+{
+    send_result(payload, final);
+}
+
+inline void wamp_invocation_impl::send_result(
+        const wamp_raw_payload& payload, wamp_invocation_impl::result_type resultType)
+{
+    throw_if_not_sendable();
+    if (resultType == intermediary && !m_progressive_results_expected)
+    {
+        //Discard intermediate results.  Other option is to throw, since method could check if progressive results are expected
+        return;
+    }
+
+    // [YIELD, INVOCATION.Request|id, Options|dict, Arguments|list, ArgumentsKw|dict]
+    std::shared_ptr<wamp_message> message;
+    if (resultType == intermediary)
+    {
+        message = std::make_shared<wamp_message>(encode_message(
+                static_cast<int>(message_type::YIELD), m_request_id,
+                std::map<std::string, bool>{ {"progress", true} }, payload));
+    }
+    else
+    {
+        message = std::make_shared<wamp_message>(encode_message(
+                static_cast<int>(message_type::YIELD), m_request_id,
+                std::map<int, int>() /* No details */, payload));
+    }
+
+    m_send_result_fn(message);
+    if (resultType != intermediary)
+    {
+        //Final result clears send function
+        m_send_result_fn = send_result_fn();
+    }
+}
+
+template <typename... Fields>
+inline wamp_message wamp_invocation_impl::encode_message(const Fields&... fields) const
+{
+    // Encode into a buffer and a zone from the session's pool, when the
+    // session has handed one over.
+    if (m_zone_pool) {
+        return encode_wamp_message(m_zone_pool, fields...);
+    }
+
+    return encode_wamp_message(fields...);
+}
+
 inline void wamp_invocation_impl::error(const std::string& error_uri)
 {
     throw_if_not_sendable();
@@ -448,6 +497,11 @@ inline void wamp_invocation_impl::set_zone(msgpack::zone&& zone)
     m_zone = std::move(zone);
 }
 
+inline void wamp_invocation_impl::set_zone_pool(const std::shared_ptr<wamp_zone_pool>& zone_pool)
+{
+    m_zone_pool = zone_pool;
+}
+
 inline void wamp_invocation_impl::set_arguments(const msgpack::object& arguments)
 {
     m_arguments = arguments;
@@ -456,6 +510,12 @@ inline void wamp_invocation_impl::set_arguments(const msgpack::object& arguments
 inline void wamp_invocation_impl::set_kw_arguments(const msgpack::object& kw_arguments)
 {
     m_kw_arguments = kw_arguments;
+    m_kw_argument_index = wamp_kw_argument_index();
+}
+
+inline void wamp_invocation_impl::set_raw_payload(const wamp_raw_payload& raw_payload)
+{
+    m_raw_payload = raw_payload;
 }
 
 inline bool wamp_invocation_impl::sendable() const
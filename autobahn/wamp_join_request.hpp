@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_JOIN_REQUEST_HPP
+#define AUTOBAHN_WAMP_JOIN_REQUEST_HPP
+
+#include "boost_config.hpp"
+
+#include <boost/exception_ptr.hpp>
+
+#include <cstdint>
+
+namespace autobahn {
+
+/// An outstanding request to join a realm.
+class wamp_join_request
+{
+public:
+    virtual ~wamp_join_request();
+
+    virtual void set_response(uint64_t session_id) = 0;
+    virtual void set_exception(const boost::exception_ptr& exception) = 0;
+};
+
+/// An outstanding request to join a realm that reports the session id through
+/// a completion, either a wamp_promise_completion or a wamp_handler_completion.
+template <typename Completion>
+class wamp_basic_join_request : public wamp_join_request
+{
+public:
+    explicit wamp_basic_join_request(Completion&& completion);
+
+    Completion& completion();
+
+    virtual void set_response(uint64_t session_id) override;
+    virtual void set_exception(const boost::exception_ptr& exception) override;
+
+private:
+    Completion m_completion;
+};
+
+} // namespace autobahn
+
+#include "wamp_join_request.ipp"
+
+#endif // AUTOBAHN_WAMP_JOIN_REQUEST_HPP
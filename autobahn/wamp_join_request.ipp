@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_join_request::~wamp_join_request()
+{
+}
+
+template <typename Completion>
+inline wamp_basic_join_request<Completion>::wamp_basic_join_request(Completion&& completion)
+    : m_completion(std::move(completion))
+{
+}
+
+template <typename Completion>
+inline Completion& wamp_basic_join_request<Completion>::completion()
+{
+    return m_completion;
+}
+
+template <typename Completion>
+inline void wamp_basic_join_request<Completion>::set_response(uint64_t session_id)
+{
+    m_completion.set_value(std::move(session_id));
+}
+
+template <typename Completion>
+inline void wamp_basic_join_request<Completion>::set_exception(const boost::exception_ptr& exception)
+{
+    m_completion.set_exception(exception);
+}
+
+} // namespace autobahn
@@ -0,0 +1,754 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "exceptions.hpp"
+#include "wamp_message.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A single pass JSON parser that builds msgpack objects in a zone. Strings
+ * without escape sequences are copied straight from the input into the zone.
+ */
+class wamp_json_serializer::parser
+{
+public:
+    parser(const char* data, std::size_t length, msgpack::zone& zone, std::size_t max_depth)
+        : m_current(data)
+        , m_end(data + length)
+        , m_zone(zone)
+        , m_max_depth(max_depth)
+        , m_scratch()
+    {
+    }
+
+    msgpack::object parse()
+    {
+        msgpack::object value;
+
+        skip_whitespace();
+        parse_value(value, 0);
+        skip_whitespace();
+
+        if (m_current != m_end) {
+            fail("unexpected data after json value");
+        }
+
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(const char* reason) const
+    {
+        throw protocol_error(std::string("invalid json message: ") + reason);
+    }
+
+    void skip_whitespace()
+    {
+        while (m_current != m_end
+                && (*m_current == ' ' || *m_current == '\n' || *m_current == '\r' || *m_current == '\t')) {
+            ++m_current;
+        }
+    }
+
+    void parse_value(msgpack::object& value, std::size_t depth)
+    {
+        if (m_current == m_end) {
+            fail("unexpected end of data");
+        }
+
+        switch (*m_current) {
+            case '{':
+                parse_object(value, depth);
+                break;
+            case '[':
+                parse_array(value, depth);
+                break;
+            case '"':
+                parse_string(value, true);
+                break;
+            case 't':
+                parse_literal("true", 4);
+                value.type = msgpack::type::BOOLEAN;
+                value.via.boolean = true;
+                break;
+            case 'f':
+                parse_literal("false", 5);
+                value.type = msgpack::type::BOOLEAN;
+                value.via.boolean = false;
+                break;
+            case 'n':
+                parse_literal("null", 4);
+                value.type = msgpack::type::NIL;
+                break;
+            default:
+                parse_number(value);
+                break;
+        }
+    }
+
+    void parse_literal(const char* literal, std::size_t length)
+    {
+        if (std::size_t(m_end - m_current) < length || memcmp(m_current, literal, length) != 0) {
+            fail("invalid literal");
+        }
+
+        m_current += length;
+    }
+
+    void parse_array(msgpack::object& value, std::size_t depth)
+    {
+        if (++depth > m_max_depth) {
+            fail("maximum nesting depth exceeded");
+        }
+
+        ++m_current;
+        std::vector<msgpack::object> elements;
+
+        skip_whitespace();
+        if (m_current != m_end && *m_current == ']') {
+            ++m_current;
+        } else {
+            for (;;) {
+                elements.emplace_back();
+                skip_whitespace();
+                parse_value(elements.back(), depth);
+                skip_whitespace();
+
+                if (m_current == m_end) {
+                    fail("unterminated array");
+                }
+
+                const char delimiter = *m_current++;
+                if (delimiter == ']') {
+                    break;
+                }
+                if (delimiter != ',') {
+                    fail("expected ',' or ']'");
+                }
+            }
+        }
+
+        value.type = msgpack::type::ARRAY;
+        value.via.array.size = static_cast<uint32_t>(elements.size());
+        value.via.array.ptr = nullptr;
+        if (!elements.empty()) {
+            value.via.array.ptr = static_cast<msgpack::object*>(
+                    m_zone.allocate_align(sizeof(msgpack::object) * elements.size()));
+            std::copy(elements.begin(), elements.end(), value.via.array.ptr);
+        }
+    }
+
+    void parse_object(msgpack::object& value, std::size_t depth)
+    {
+        if (++depth > m_max_depth) {
+            fail("maximum nesting depth exceeded");
+        }
+
+        ++m_current;
+        std::vector<msgpack::object_kv> entries;
+
+        skip_whitespace();
+        if (m_current != m_end && *m_current == '}') {
+            ++m_current;
+        } else {
+            for (;;) {
+                entries.emplace_back();
+                skip_whitespace();
+                if (m_current == m_end || *m_current != '"') {
+                    fail("expected object key");
+                }
+                parse_string(entries.back().key, false);
+
+                skip_whitespace();
+                if (m_current == m_end || *m_current != ':') {
+                    fail("expected ':'");
+                }
+                ++m_current;
+
+                skip_whitespace();
+                parse_value(entries.back().val, depth);
+                skip_whitespace();
+
+                if (m_current == m_end) {
+                    fail("unterminated object");
+                }
+
+                const char delimiter = *m_current++;
+                if (delimiter == '}') {
+                    break;
+                }
+                if (delimiter != ',') {
+                    fail("expected ',' or '}'");
+                }
+            }
+        }
+
+        value.type = msgpack::type::MAP;
+        value.via.map.size = static_cast<uint32_t>(entries.size());
+        value.via.map.ptr = nullptr;
+        if (!entries.empty()) {
+            value.via.map.ptr = static_cast<msgpack::object_kv*>(
+                    m_zone.allocate_align(sizeof(msgpack::object_kv) * entries.size()));
+            std::copy(entries.begin(), entries.end(), value.via.map.ptr);
+        }
+    }
+
+    void parse_string(msgpack::object& value, bool allow_binary)
+    {
+        ++m_current;
+        const char* start = m_current;
+
+        while (m_current != m_end && *m_current != '"' && *m_current != '\\') {
+            if (static_cast<unsigned char>(*m_current) < 0x20) {
+                fail("control character in string");
+            }
+            ++m_current;
+        }
+
+        if (m_current == m_end) {
+            fail("unterminated string");
+        }
+
+        const char* data = start;
+        std::size_t length = m_current - start;
+
+        if (*m_current == '"') {
+            ++m_current;
+        } else {
+            // Escape sequences have to be decoded into the scratch buffer.
+            m_scratch.assign(start, m_current);
+            for (;;) {
+                if (m_current == m_end) {
+                    fail("unterminated string");
+                }
+
+                const char c = *m_current++;
+                if (c == '"') {
+                    break;
+                } else if (c == '\\') {
+                    parse_escape();
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    fail("control character in string");
+                } else {
+                    m_scratch.push_back(c);
+                }
+            }
+
+            data = m_scratch.data();
+            length = m_scratch.size();
+        }
+
+        if (allow_binary && length > 0 && data[0] == '\0') {
+            decode_binary(data + 1, length - 1, value);
+            return;
+        }
+
+        char* ptr = nullptr;
+        if (length > 0) {
+            ptr = static_cast<char*>(m_zone.allocate_no_align(length));
+            memcpy(ptr, data, length);
+        }
+
+        value.type = msgpack::type::STR;
+        value.via.str.size = static_cast<uint32_t>(length);
+        value.via.str.ptr = ptr;
+    }
+
+    void parse_escape()
+    {
+        if (m_current == m_end) {
+            fail("unterminated escape sequence");
+        }
+
+        const char c = *m_current++;
+        switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                m_scratch.push_back(c);
+                break;
+            case 'b':
+                m_scratch.push_back('\b');
+                break;
+            case 'f':
+                m_scratch.push_back('\f');
+                break;
+            case 'n':
+                m_scratch.push_back('\n');
+                break;
+            case 'r':
+                m_scratch.push_back('\r');
+                break;
+            case 't':
+                m_scratch.push_back('\t');
+                break;
+            case 'u': {
+                uint32_t code_point = parse_hex4();
+                if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+                    if (m_end - m_current < 2 || m_current[0] != '\\' || m_current[1] != 'u') {
+                        fail("unpaired surrogate");
+                    }
+                    m_current += 2;
+
+                    const uint32_t low = parse_hex4();
+                    if (low < 0xDC00 || low > 0xDFFF) {
+                        fail("unpaired surrogate");
+                    }
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                } else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+                    fail("unpaired surrogate");
+                }
+                append_utf8(code_point);
+                break;
+            }
+            default:
+                fail("invalid escape sequence");
+        }
+    }
+
+    uint32_t parse_hex4()
+    {
+        if (m_end - m_current < 4) {
+            fail("truncated unicode escape");
+        }
+
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = *m_current++;
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                value |= c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'F') {
+                value |= c - 'A' + 10;
+            } else {
+                fail("invalid unicode escape");
+            }
+        }
+
+        return value;
+    }
+
+    void append_utf8(uint32_t code_point)
+    {
+        if (code_point < 0x80) {
+            m_scratch.push_back(static_cast<char>(code_point));
+        } else if (code_point < 0x800) {
+            m_scratch.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+            m_scratch.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else if (code_point < 0x10000) {
+            m_scratch.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+            m_scratch.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            m_scratch.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else {
+            m_scratch.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+            m_scratch.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+            m_scratch.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            m_scratch.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+    }
+
+    void decode_binary(const char* data, std::size_t length, msgpack::object& value)
+    {
+        while (length > 0 && data[length - 1] == '=') {
+            --length;
+        }
+
+        if (length % 4 == 1) {
+            fail("invalid base64 length");
+        }
+
+        const std::size_t size = length / 4 * 3 + (length % 4 == 0 ? 0 : length % 4 - 1);
+        char* ptr = nullptr;
+        if (size > 0) {
+            ptr = static_cast<char*>(m_zone.allocate_no_align(size));
+        }
+
+        uint32_t bits = 0;
+        int num_bits = 0;
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            const int sextet = base64_value(data[i]);
+            if (sextet < 0) {
+                fail("invalid base64 character");
+            }
+
+            bits = (bits << 6) | static_cast<uint32_t>(sextet);
+            num_bits += 6;
+            if (num_bits >= 8) {
+                num_bits -= 8;
+                ptr[offset++] = static_cast<char>((bits >> num_bits) & 0xFF);
+            }
+        }
+
+        value.type = msgpack::type::BIN;
+        value.via.bin.size = static_cast<uint32_t>(size);
+        value.via.bin.ptr = ptr;
+    }
+
+    static int base64_value(char c)
+    {
+        if (c >= 'A' && c <= 'Z') {
+            return c - 'A';
+        } else if (c >= 'a' && c <= 'z') {
+            return c - 'a' + 26;
+        } else if (c >= '0' && c <= '9') {
+            return c - '0' + 52;
+        } else if (c == '+') {
+            return 62;
+        } else if (c == '/') {
+            return 63;
+        }
+
+        return -1;
+    }
+
+    static bool is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    void parse_number(msgpack::object& value)
+    {
+        const char* start = m_current;
+        bool negative = false;
+        bool integral = true;
+
+        if (*m_current == '-') {
+            negative = true;
+            ++m_current;
+        }
+
+        if (m_current == m_end || !is_digit(*m_current)) {
+            fail("invalid value");
+        }
+
+        if (*m_current == '0') {
+            ++m_current;
+        } else {
+            while (m_current != m_end && is_digit(*m_current)) {
+                ++m_current;
+            }
+        }
+
+        if (m_current != m_end && *m_current == '.') {
+            integral = false;
+            ++m_current;
+            if (m_current == m_end || !is_digit(*m_current)) {
+                fail("invalid number");
+            }
+            while (m_current != m_end && is_digit(*m_current)) {
+                ++m_current;
+            }
+        }
+
+        if (m_current != m_end && (*m_current == 'e' || *m_current == 'E')) {
+            integral = false;
+            ++m_current;
+            if (m_current != m_end && (*m_current == '+' || *m_current == '-')) {
+                ++m_current;
+            }
+            if (m_current == m_end || !is_digit(*m_current)) {
+                fail("invalid number");
+            }
+            while (m_current != m_end && is_digit(*m_current)) {
+                ++m_current;
+            }
+        }
+
+        if (integral) {
+            const uint64_t max = std::numeric_limits<uint64_t>::max();
+            uint64_t magnitude = 0;
+            bool overflow = false;
+            for (const char* digit = start + (negative ? 1 : 0); digit != m_current; ++digit) {
+                const uint64_t d = static_cast<uint64_t>(*digit - '0');
+                if (magnitude > (max - d) / 10) {
+                    overflow = true;
+                    break;
+                }
+                magnitude = magnitude * 10 + d;
+            }
+
+            const uint64_t min_magnitude =
+                    static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1;
+            if (!overflow && (!negative || magnitude == 0)) {
+                value.type = msgpack::type::POSITIVE_INTEGER;
+                value.via.u64 = magnitude;
+                return;
+            } else if (!overflow && magnitude <= min_magnitude) {
+                value.type = msgpack::type::NEGATIVE_INTEGER;
+                value.via.i64 = magnitude == min_magnitude
+                        ? std::numeric_limits<int64_t>::min()
+                        : -static_cast<int64_t>(magnitude);
+                return;
+            }
+        }
+
+        // Integers that do not fit into 64 bits end up as doubles as well.
+        const std::string text(start, m_current);
+        value.type = msgpack::type::FLOAT64;
+        value.via.f64 = strtod(text.c_str(), nullptr);
+    }
+
+private:
+    const char* m_current;
+    const char* m_end;
+    msgpack::zone& m_zone;
+    std::size_t m_max_depth;
+    std::string m_scratch;
+};
+
+inline wamp_json_serializer::wamp_json_serializer(std::size_t max_depth)
+    : m_max_depth(max_depth)
+{
+}
+
+inline const char* wamp_json_serializer::name() const
+{
+    return "json";
+}
+
+inline const char* wamp_json_serializer::subprotocol() const
+{
+    return "wamp.2.json";
+}
+
+inline wamp_rawsocket_serializer wamp_json_serializer::rawsocket_id() const
+{
+    return wamp_rawsocket_serializer::json;
+}
+
+inline bool wamp_json_serializer::is_binary() const
+{
+    return false;
+}
+
+inline void wamp_json_serializer::serialize(
+        const wamp_message& message, msgpack::sbuffer& buffer) const
+{
+    buffer.write("[", 1);
+    for (std::size_t index = 0; index < message.size(); ++index) {
+        if (index > 0) {
+            buffer.write(",", 1);
+        }
+        write_value(message.field(index), buffer);
+    }
+    buffer.write("]", 1);
+}
+
+inline wamp_message wamp_json_serializer::deserialize(
+        const char* data, std::size_t length) const
+{
+    msgpack::zone zone;
+    parser json_parser(data, length, zone, m_max_depth);
+
+    msgpack::object array = json_parser.parse();
+    if (array.type != msgpack::type::ARRAY) {
+        throw protocol_error("invalid json message: not an array");
+    }
+
+    return wamp_message(array, std::move(zone));
+}
+
+inline void wamp_json_serializer::write_value(
+        const msgpack::object& value, msgpack::sbuffer& buffer)
+{
+    char text[32];
+
+    switch (value.type) {
+        case msgpack::type::NIL:
+            buffer.write("null", 4);
+            break;
+        case msgpack::type::BOOLEAN:
+            if (value.via.boolean) {
+                buffer.write("true", 4);
+            } else {
+                buffer.write("false", 5);
+            }
+            break;
+        case msgpack::type::POSITIVE_INTEGER:
+            buffer.write(text, snprintf(text, sizeof(text), "%llu",
+                    static_cast<unsigned long long>(value.via.u64)));
+            break;
+        case msgpack::type::NEGATIVE_INTEGER:
+            buffer.write(text, snprintf(text, sizeof(text), "%lld",
+                    static_cast<long long>(value.via.i64)));
+            break;
+        case msgpack::type::FLOAT32:
+        case msgpack::type::FLOAT64:
+            // JSON has no representation for infinity and NaN.
+            if (std::isfinite(value.via.f64)) {
+                buffer.write(text, snprintf(text, sizeof(text), "%.17g", value.via.f64));
+            } else {
+                buffer.write("null", 4);
+            }
+            break;
+        case msgpack::type::STR:
+            write_string(value.via.str.ptr, value.via.str.size, buffer);
+            break;
+        case msgpack::type::BIN:
+            write_binary(value.via.bin.ptr, value.via.bin.size, buffer);
+            break;
+        case msgpack::type::ARRAY:
+            buffer.write("[", 1);
+            for (uint32_t i = 0; i < value.via.array.size; ++i) {
+                if (i > 0) {
+                    buffer.write(",", 1);
+                }
+                write_value(value.via.array.ptr[i], buffer);
+            }
+            buffer.write("]", 1);
+            break;
+        case msgpack::type::MAP:
+            buffer.write("{", 1);
+            for (uint32_t i = 0; i < value.via.map.size; ++i) {
+                const msgpack::object_kv& entry = value.via.map.ptr[i];
+                if (entry.key.type != msgpack::type::STR) {
+                    throw protocol_error("json object keys must be strings");
+                }
+
+                if (i > 0) {
+                    buffer.write(",", 1);
+                }
+                write_string(entry.key.via.str.ptr, entry.key.via.str.size, buffer);
+                buffer.write(":", 1);
+                write_value(entry.val, buffer);
+            }
+            buffer.write("}", 1);
+            break;
+        default:
+            throw protocol_error("msgpack extension types cannot be serialized as json");
+    }
+}
+
+inline void wamp_json_serializer::write_string(
+        const char* data, std::size_t length, msgpack::sbuffer& buffer)
+{
+    buffer.write("\"", 1);
+
+    // Characters that need no escaping are written in runs.
+    const char* run = data;
+    const char* end = data + length;
+    for (const char* current = data; current != end; ++current) {
+        const unsigned char c = static_cast<unsigned char>(*current);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        buffer.write(run, current - run);
+        run = current + 1;
+
+        char escape[8];
+        switch (c) {
+            case '"':
+                buffer.write("\\\"", 2);
+                break;
+            case '\\':
+                buffer.write("\\\\", 2);
+                break;
+            case '\b':
+                buffer.write("\\b", 2);
+                break;
+            case '\f':
+                buffer.write("\\f", 2);
+                break;
+            case '\n':
+                buffer.write("\\n", 2);
+                break;
+            case '\r':
+                buffer.write("\\r", 2);
+                break;
+            case '\t':
+                buffer.write("\\t", 2);
+                break;
+            default:
+                buffer.write(escape, snprintf(escape, sizeof(escape), "\\u%04x", c));
+                break;
+        }
+    }
+
+    buffer.write(run, end - run);
+    buffer.write("\"", 1);
+}
+
+inline void wamp_json_serializer::write_binary(
+        const char* data, std::size_t length, msgpack::sbuffer& buffer)
+{
+    static const char alphabet[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    buffer.write("\"\\u0000", 7);
+
+    // Encode in chunks to avoid writing to the buffer one character at a time.
+    char chunk[256];
+    std::size_t chunk_size = 0;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+
+    std::size_t i = 0;
+    for (; i + 3 <= length; i += 3) {
+        const uint32_t triple = (uint32_t(bytes[i]) << 16) | (uint32_t(bytes[i + 1]) << 8) | bytes[i + 2];
+        chunk[chunk_size++] = alphabet[(triple >> 18) & 0x3F];
+        chunk[chunk_size++] = alphabet[(triple >> 12) & 0x3F];
+        chunk[chunk_size++] = alphabet[(triple >> 6) & 0x3F];
+        chunk[chunk_size++] = alphabet[triple & 0x3F];
+
+        if (chunk_size == sizeof(chunk)) {
+            buffer.write(chunk, chunk_size);
+            chunk_size = 0;
+        }
+    }
+
+    if (i < length) {
+        uint32_t triple = uint32_t(bytes[i]) << 16;
+        if (i + 1 < length) {
+            triple |= uint32_t(bytes[i + 1]) << 8;
+        }
+
+        chunk[chunk_size++] = alphabet[(triple >> 18) & 0x3F];
+        chunk[chunk_size++] = alphabet[(triple >> 12) & 0x3F];
+        chunk[chunk_size++] = i + 1 < length ? alphabet[(triple >> 6) & 0x3F] : '=';
+        chunk[chunk_size++] = '=';
+    }
+
+    buffer.write(chunk, chunk_size);
+    buffer.write("\"", 1);
+}
+
+} // namespace autobahn
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_KW_ARGUMENT_INDEX_HPP
+#define AUTOBAHN_WAMP_KW_ARGUMENT_INDEX_HPP
+
+#include <msgpack/object.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A hash index over the string keys of a keyword arguments map. Looking a
+ * key up in a msgpack map scans it entry by entry, so reading many keyword
+ * arguments from a large map is quadratic. The index is built on the first
+ * lookup in a map with more than a handful of entries and makes every
+ * further lookup constant time. Smaller maps are still scanned, which is
+ * cheaper than hashing them.
+ *
+ * The index refers to the entries of the map by position and is rebuilt
+ * whenever it is asked about a different map.
+ *
+ * Lookups modify the index, so it is not thread safe. The events,
+ * invocations and call results that own an index have to be synchronized
+ * externally if they are accessed from several threads.
+ */
+class wamp_kw_argument_index
+{
+public:
+    /*!
+     * Constructs an empty index.
+     */
+    wamp_kw_argument_index();
+
+    /*!
+     * Looks up a key in a keyword arguments map. Throws a msgpack::type_error
+     * if the object is not a map.
+     *
+     * @param map The keyword arguments.
+     * @param key The first octet of the key.
+     * @param key_size The number of octets in the key.
+     *
+     * @return The value for the key, or nullptr if the map does not have it.
+     */
+    const msgpack::object* find(const msgpack::object& map, const char* key, std::size_t key_size);
+
+private:
+    /*!
+     * Hashes the octets of a key (32 bit FNV-1a).
+     */
+    static std::uint32_t hash(const char* key, std::size_t key_size);
+
+    /*!
+     * Hashes all string keys of the map into the slots.
+     */
+    void build(const msgpack::object& map);
+
+    /*!
+     * The entries of the indexed map, or nullptr if nothing has been
+     * indexed yet.
+     */
+    const msgpack::object_kv* m_entries;
+
+    /*!
+     * The open addressing table, whose size is a power of two. A slot holds
+     * the position of an entry plus one, or zero if it is empty.
+     */
+    std::vector<std::uint32_t> m_slots;
+
+    /*!
+     * The key hash of each entry, so that probing only compares the keys
+     * of entries whose hash matches.
+     */
+    std::vector<std::uint32_t> m_hashes;
+};
+
+} // namespace autobahn
+
+#include "wamp_kw_argument_index.ipp"
+
+#endif // AUTOBAHN_WAMP_KW_ARGUMENT_INDEX_HPP
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+namespace autobahn {
+
+// Maps with at most this many entries are scanned rather than indexed.
+static const std::size_t KW_ARGUMENT_INDEX_THRESHOLD = 8;
+
+inline wamp_kw_argument_index::wamp_kw_argument_index()
+    : m_entries(nullptr)
+    , m_slots()
+    , m_hashes()
+{
+}
+
+inline const msgpack::object* wamp_kw_argument_index::find(
+        const msgpack::object& map, const char* key, std::size_t key_size)
+{
+    if (map.type != msgpack::type::MAP) {
+        throw msgpack::type_error();
+    }
+
+    const msgpack::object_kv* entries = map.via.map.ptr;
+    if (map.via.map.size <= KW_ARGUMENT_INDEX_THRESHOLD) {
+        for (std::size_t i = 0; i < map.via.map.size; ++i) {
+            const msgpack::object_kv& kv = entries[i];
+            if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
+                    && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
+            {
+                return &kv.val;
+            }
+        }
+        return nullptr;
+    }
+
+    if (m_entries != entries || m_hashes.size() != map.via.map.size) {
+        build(map);
+    }
+
+    const std::uint32_t key_hash = hash(key, key_size);
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t slot = key_hash & mask; m_slots[slot] != 0; slot = (slot + 1) & mask) {
+        const std::size_t i = m_slots[slot] - 1;
+        const msgpack::object_kv& kv = entries[i];
+        if (m_hashes[i] == key_hash && key_size == kv.key.via.str.size
+                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
+        {
+            return &kv.val;
+        }
+    }
+    return nullptr;
+}
+
+inline std::uint32_t wamp_kw_argument_index::hash(const char* key, std::size_t key_size)
+{
+    std::uint32_t result = 2166136261u;
+    for (std::size_t i = 0; i < key_size; ++i) {
+        result ^= static_cast<std::uint8_t>(key[i]);
+        result *= 16777619u;
+    }
+    return result;
+}
+
+inline void wamp_kw_argument_index::build(const msgpack::object& map)
+{
+    // Keep the table at most half full so that probe sequences stay short.
+    std::size_t num_slots = 16;
+    while (num_slots < 2 * map.via.map.size) {
+        num_slots *= 2;
+    }
+
+    m_entries = map.via.map.ptr;
+    m_slots.assign(num_slots, 0);
+    m_hashes.assign(map.via.map.size, 0);
+
+    const std::size_t mask = num_slots - 1;
+    for (std::size_t i = 0; i < map.via.map.size; ++i) {
+        const msgpack::object& key = m_entries[i].key;
+        if (key.type != msgpack::type::STR) {
+            continue;
+        }
+
+        m_hashes[i] = hash(key.via.str.ptr, key.via.str.size);
+        std::size_t slot = m_hashes[i] & mask;
+        while (m_slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        m_slots[slot] = static_cast<std::uint32_t>(i + 1);
+    }
+}
+
+} // namespace autobahn
@@ -31,10 +31,14 @@
 #ifndef AUTOBAHN_WAMP_MESSAGE_HPP
 #define AUTOBAHN_WAMP_MESSAGE_HPP
 
+#include "wamp_zone_pool.hpp"
+
 #include <msgpack/zone.hpp>
 #include <msgpack/object.hpp>
+#include <msgpack/sbuffer.hpp>
 
 #include <cstddef>
+#include <memory>
 #include <vector>
 
 namespace autobahn {
@@ -76,6 +80,16 @@ public:
      */
     wamp_message(std::size_t num_fields, msgpack::zone&& zone);
 
+    /*!
+     * Constructs a wamp message with the given number of fields whose
+     * zone is borrowed from a pool. The zone is handed back to the pool
+     * when the message is destroyed.
+     *
+     * @param num_fields The number of fields in the message.
+     * @param zone_pool The pool to borrow the zone from.
+     */
+    wamp_message(std::size_t num_fields, const std::shared_ptr<wamp_zone_pool>& zone_pool);
+
     /*!
      * Constructs a wamp message with the given fields.
      *
@@ -84,9 +98,45 @@ public:
      */
     wamp_message(message_fields&& fields, msgpack::zone&& zone);
 
+    /*!
+     * Constructs a wamp message that wraps the elements of an unpacked
+     * message array in place instead of copying them into a new vector.
+     * The fields are only copied if the message gets modified or its
+     * fields are pilfered. Throws an exception if the object is not an
+     * array.
+     *
+     * @param array The unpacked message array.
+     * @param zone The zone that the array elements were allocated in.
+     */
+    wamp_message(const msgpack::object& array, msgpack::zone&& zone);
+
+    /*!
+     * Constructs a wamp message from a message that has already been
+     * packed as a msgpack array, such as a received message or one built
+     * by encode_wamp_message(). The msgpack serializer sends the packed
+     * message as is. Each field is only unpacked when it is first accessed,
+     * its type can be checked without unpacking it.
+     *
+     * @param encoded The packed message.
+     */
+    explicit wamp_message(std::unique_ptr<msgpack::sbuffer>&& encoded);
+
+    /*!
+     * Constructs a wamp message from a packed message whose buffer came
+     * from a pool, borrowing its zone from the same pool. Both are handed
+     * back to the pool when the message is destroyed.
+     *
+     * @param encoded The packed message.
+     * @param zone_pool The pool to borrow the zone from.
+     */
+    wamp_message(std::unique_ptr<msgpack::sbuffer>&& encoded,
+            const std::shared_ptr<wamp_zone_pool>& zone_pool);
+
     wamp_message(const wamp_message& other) = delete;
     wamp_message(wamp_message&& other);
 
+    ~wamp_message();
+
     wamp_message& operator=(const wamp_message& other) = delete;
     wamp_message& operator=(wamp_message&& other);
 
@@ -126,6 +176,8 @@ public:
 
     /*!
      * Determines if the field at the specified index is of the given type.
+     * For a packed message the type is read from the field's header where
+     * possible, so checking a field does not unpack it.
      *
      * @param index The index of the target field.
      * @param type The field type to check against.
@@ -160,19 +212,129 @@ public:
      */
     msgpack::zone&& zone();
 
+    /*!
+     * Whether or not the message holds an already packed msgpack array.
+     */
+    bool is_encoded() const;
+
+    /*!
+     * The packed message. Only valid if the message is encoded.
+     */
+    const msgpack::sbuffer& encoded() const;
+
+    /*!
+     * Retrieves the packed fields from the specified index up to the end
+     * of an encoded message. The packed fields remain valid for as long
+     * as the message, or its zone once that has been pilfered. Returns
+     * false if the message is not encoded or if its zone has already
+     * been pilfered.
+     *
+     * @param index The index of the first field.
+     * @param data Set to the first octet of the packed fields.
+     * @param size Set to the number of octets.
+     */
+    bool packed_fields(std::size_t index, const char*& data, std::size_t& size) const;
+
+    /*!
+     * Whether or not a packed msgpack message is worth decoding lazily,
+     * judged by the message type that follows the array header. These
+     * are the messages that carry application payloads, EVENT, RESULT and
+     * INVOCATION, whose packed arguments can be passed on as they are.
+     *
+     * @param data The first octet of the packed message.
+     * @param size The number of octets.
+     */
+    static bool is_lazily_decoded(const char* data, std::size_t size);
+
 private:
+    /*!
+     * The location of a field within the packed message.
+     */
+    struct packed_field
+    {
+        std::size_t offset;
+        std::size_t size;
+        bool decoded;
+    };
+
+    /*!
+     * Locates the fields of an encoded message without unpacking them.
+     * Throws an exception if the message is not a well formed msgpack
+     * array.
+     */
+    void index_fields() const;
+
+    /*!
+     * Unpacks the field at the specified index of an encoded message
+     * unless it has been unpacked already.
+     */
+    void decode_field(std::size_t index) const;
+
+    /*!
+     * Unpacks all remaining fields of an encoded message and hands the
+     * packed message over to the zone, since the unpacked fields
+     * reference it.
+     */
+    void release_encoded();
+
+    /*!
+     * Copies the wrapped array elements into the message fields so
+     * that they can be modified or pilfered.
+     */
+    void materialize_fields();
+
+    /*!
+     * Returns the offset just past the msgpack object that starts at the
+     * given offset. Throws an exception if the object is malformed or
+     * truncated.
+     */
+    static std::size_t skip_object(const char* data, std::size_t size, std::size_t offset);
+
+    static bool reference_field(
+            msgpack::type::object_type type, std::size_t length, void* user_data);
+
     /*!
      * The zone used to allocate message fields. The zone must outlive
      * the fields. If the fields are pilfered then the zone must also
-     * be pilferred and stored along with the fields.
+     * be pilferred and stored along with the fields. Mutable since an
+     * encoded message is unpacked on first access.
      */
-    msgpack::zone m_zone;
+    mutable msgpack::zone m_zone;
 
     /*!
      * The fields comprising of the message. It is up to the user of this
      * class to ensure that a valid wamp message has been constructed.
+     * For an encoded message these hold the fields unpacked so far.
+     */
+    mutable message_fields m_fields;
+
+    /*!
+     * The elements of the unpacked array wrapped by the message, or null
+     * if the message uses its own fields.
+     */
+    mutable const msgpack::object* m_field_view;
+
+    /*!
+     * The number of wrapped array elements.
+     */
+    mutable std::size_t m_field_view_size;
+
+    /*!
+     * The packed message, or null if the message is not encoded.
+     */
+    std::unique_ptr<msgpack::sbuffer> m_encoded;
+
+    /*!
+     * The locations of the fields of the encoded message, empty until
+     * the message has been indexed.
+     */
+    mutable std::vector<packed_field> m_packed_fields;
+
+    /*!
+     * The pool that the zone, and the buffer of an encoded message, have
+     * been borrowed from, if any.
      */
-    message_fields m_fields;
+    std::shared_ptr<wamp_zone_pool> m_zone_pool;
 };
 
 /// Convenience operator for outputting a raw wamp message.
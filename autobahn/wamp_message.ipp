@@ -30,6 +30,8 @@
 
 #include "wamp_message_type.hpp"
 
+#include <msgpack/pack.hpp>
+#include <msgpack/unpack.hpp>
 #include <stdexcept>
 
 namespace autobahn {
@@ -37,25 +39,107 @@ namespace autobahn {
 inline wamp_message::wamp_message(std::size_t num_fields)
     : m_zone()
     , m_fields(num_fields)
+    , m_field_view(nullptr)
+    , m_field_view_size(0)
+    , m_encoded()
+    , m_packed_fields()
+    , m_zone_pool()
 {
 }
 
 inline wamp_message::wamp_message(std::size_t num_fields, msgpack::zone&& zone)
     : m_zone(std::move(zone))
     , m_fields(num_fields)
+    , m_field_view(nullptr)
+    , m_field_view_size(0)
+    , m_encoded()
+    , m_packed_fields()
+    , m_zone_pool()
+{
+}
+
+inline wamp_message::wamp_message(
+        std::size_t num_fields, const std::shared_ptr<wamp_zone_pool>& zone_pool)
+    : m_zone(zone_pool->acquire())
+    , m_fields(num_fields)
+    , m_field_view(nullptr)
+    , m_field_view_size(0)
+    , m_encoded()
+    , m_packed_fields()
+    , m_zone_pool(zone_pool)
 {
 }
 
 inline wamp_message::wamp_message(message_fields&& fields, msgpack::zone&& zone)
     : m_zone(std::move(zone))
     , m_fields(std::move(fields))
+    , m_field_view(nullptr)
+    , m_field_view_size(0)
+    , m_encoded()
+    , m_packed_fields()
+    , m_zone_pool()
+{
+}
+
+inline wamp_message::wamp_message(const msgpack::object& array, msgpack::zone&& zone)
+    : m_zone(std::move(zone))
+    , m_fields()
+    , m_field_view(nullptr)
+    , m_field_view_size(0)
+    , m_encoded()
+    , m_packed_fields()
+    , m_zone_pool()
+{
+    if (array.type != msgpack::type::ARRAY) {
+        throw msgpack::type_error();
+    }
+
+    m_field_view = array.via.array.ptr;
+    m_field_view_size = array.via.array.size;
+}
+
+inline wamp_message::wamp_message(std::unique_ptr<msgpack::sbuffer>&& encoded)
+    : m_zone()
+    , m_fields()
+    , m_field_view(nullptr)
+    , m_field_view_size(0)
+    , m_encoded(std::move(encoded))
+    , m_packed_fields()
+    , m_zone_pool()
+{
+}
+
+inline wamp_message::wamp_message(
+        std::unique_ptr<msgpack::sbuffer>&& encoded, const std::shared_ptr<wamp_zone_pool>& zone_pool)
+    : m_zone(zone_pool->acquire())
+    , m_fields()
+    , m_field_view(nullptr)
+    , m_field_view_size(0)
+    , m_encoded(std::move(encoded))
+    , m_packed_fields()
+    , m_zone_pool(zone_pool)
 {
 }
 
 inline wamp_message::wamp_message(wamp_message&& other)
+    : m_zone(std::move(other.m_zone))
+    , m_fields(std::move(other.m_fields))
+    , m_field_view(other.m_field_view)
+    , m_field_view_size(other.m_field_view_size)
+    , m_encoded(std::move(other.m_encoded))
+    , m_packed_fields(std::move(other.m_packed_fields))
+    , m_zone_pool(std::move(other.m_zone_pool))
 {
-    m_zone = std::move(other.m_zone);
-    m_fields = std::move(other.m_fields);
+    other.m_field_view = nullptr;
+    other.m_field_view_size = 0;
+}
+
+inline wamp_message::~wamp_message()
+{
+    if (m_zone_pool) {
+        m_zone_pool->release(std::move(m_zone));
+        m_zone_pool->release_buffer(std::move(m_encoded));
+    }
 }
 
 inline wamp_message& wamp_message::operator=(wamp_message&& other)
@@ -64,65 +148,341 @@ inline wamp_message& wamp_message::operator=(wamp_message&& other)
         return *this;
     }
 
+    if (m_zone_pool) {
+        m_zone_pool->release(std::move(m_zone));
+        m_zone_pool->release_buffer(std::move(m_encoded));
+    }
+
     m_zone = std::move(other.m_zone);
     m_fields = std::move(other.m_fields);
+    m_field_view = other.m_field_view;
+    m_field_view_size = other.m_field_view_size;
+    m_encoded = std::move(other.m_encoded);
+    m_packed_fields = std::move(other.m_packed_fields);
+    m_zone_pool = std::move(other.m_zone_pool);
+
+    other.m_field_view = nullptr;
+    other.m_field_view_size = 0;
 
     return *this;
 }
 
 inline const msgpack::object& wamp_message::field(std::size_t index) const
 {
-    if (index >= m_fields.size()) {
+    if (index >= size()) {
         throw std::out_of_range("invalid message field index");
     }
 
+    if (m_field_view) {
+        return m_field_view[index];
+    }
+
+    decode_field(index);
     return m_fields[index];
 }
 
 template <typename Type>
 inline Type wamp_message::field(std::size_t index)
 {
-    if (index >= m_fields.size()) {
-        throw std::out_of_range("invalid message field index");
-    }
-
-    return m_fields[index].as<Type>();
+    return static_cast<const wamp_message&>(*this).field(index).as<Type>();
 }
 
 template <typename Type>
 inline void wamp_message::set_field(std::size_t index, const Type& type)
 {
-    if (index >= m_fields.size()) {
+    if (index >= size()) {
         throw std::out_of_range("invalid message field index");
     }
 
+    materialize_fields();
     m_fields[index] = msgpack::object(type, m_zone);
 }
 
 inline bool wamp_message::is_field_type(std::size_t index, msgpack::type::object_type type) const
 {
-    if (index >= m_fields.size()) {
+    if (index >= size()) {
         throw std::out_of_range("invalid message field index");
     }
 
-    return m_fields[index].type == type;
+    if (index >= m_packed_fields.size() || m_packed_fields[index].decoded) {
+        return field(index).type == type;
+    }
+
+    // Signed integers and floats are left to the unpacker, since the
+    // object type they unpack to depends on their value and on the
+    // msgpack version.
+    const uint8_t header = static_cast<uint8_t>(m_encoded->data()[m_packed_fields[index].offset]);
+    if (header <= 0x7f || (header >= 0xcc && header <= 0xcf)) {
+        return type == msgpack::type::POSITIVE_INTEGER;
+    }
+    if (header >= 0xe0) {
+        return type == msgpack::type::NEGATIVE_INTEGER;
+    }
+    if (header <= 0x8f || header == 0xde || header == 0xdf) {
+        return type == msgpack::type::MAP;
+    }
+    if (header <= 0x9f || header == 0xdc || header == 0xdd) {
+        return type == msgpack::type::ARRAY;
+    }
+    if (header <= 0xbf || (header >= 0xd9 && header <= 0xdb)) {
+        return type == msgpack::type::STR;
+    }
+    if (header == 0xc0) {
+        return type == msgpack::type::NIL;
+    }
+    if (header == 0xc2 || header == 0xc3) {
+        return type == msgpack::type::BOOLEAN;
+    }
+    if (header >= 0xc4 && header <= 0xc6) {
+        return type == msgpack::type::BIN;
+    }
+
+    return field(index).type == type;
 }
 
 inline std::size_t wamp_message::size() const
 {
-    return m_fields.size();
+    index_fields();
+    return m_field_view ? m_field_view_size : m_fields.size();
 }
 
 inline wamp_message::message_fields&& wamp_message::fields()
 {
+    materialize_fields();
     return std::move(m_fields);
 }
 
 inline msgpack::zone&& wamp_message::zone()
 {
+    // A pilfered zone must not be handed back to the pool.
+    m_zone_pool.reset();
+    release_encoded();
     return std::move(m_zone);
 }
 
+inline bool wamp_message::is_encoded() const
+{
+    return m_encoded != nullptr;
+}
+
+inline const msgpack::sbuffer& wamp_message::encoded() const
+{
+    return *m_encoded;
+}
+
+inline bool wamp_message::packed_fields(
+        std::size_t index, const char*& data, std::size_t& size) const
+{
+    index_fields();
+    if (!m_encoded || index > m_packed_fields.size()) {
+        return false;
+    }
+
+    const std::size_t offset = index < m_packed_fields.size()
+            ? m_packed_fields[index].offset : m_encoded->size();
+    data = m_encoded->data() + offset;
+    size = m_encoded->size() - offset;
+    return true;
+}
+
+inline bool wamp_message::is_lazily_decoded(const char* data, std::size_t size)
+{
+    // The array header is a fixarray, an array 16 or an array 32. Message
+    // types are small enough to be a positive fixint.
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    std::size_t offset = 0;
+    if (size > 0 && (bytes[0] & 0xF0) == 0x90) {
+        offset = 1;
+    } else if (size > 0 && bytes[0] == 0xDC) {
+        offset = 3;
+    } else if (size > 0 && bytes[0] == 0xDD) {
+        offset = 5;
+    } else {
+        return false;
+    }
+
+    if (size <= offset) {
+        return false;
+    }
+
+    switch (static_cast<message_type>(bytes[offset])) {
+        case message_type::EVENT:
+        case message_type::RESULT:
+        case message_type::INVOCATION:
+            return true;
+        default:
+            return false;
+    }
+}
+
+inline void wamp_message::index_fields() const
+{
+    if (!m_encoded || !m_packed_fields.empty()) {
+        return;
+    }
+
+    const char* data = m_encoded->data();
+    const std::size_t size = m_encoded->size();
+    if (size == 0) {
+        throw msgpack::insufficient_bytes("insufficient bytes");
+    }
+
+    // Only the array header is read here, the fields are skipped over.
+    const uint8_t header = static_cast<uint8_t>(data[0]);
+    std::size_t offset = 1;
+    std::size_t num_fields = 0;
+    if (header >= 0x90 && header <= 0x9f) {
+        num_fields = header & 0x0f;
+    } else if (header == 0xdc || header == 0xdd) {
+        const std::size_t length = header == 0xdc ? 2 : 4;
+        if (size < offset + length) {
+            throw msgpack::insufficient_bytes("insufficient bytes");
+        }
+        for (std::size_t i = 0; i < length; ++i) {
+            num_fields = (num_fields << 8) | static_cast<uint8_t>(data[offset++]);
+        }
+    } else {
+        throw msgpack::parse_error("message is not an array");
+    }
+
+    // Every field takes up at least one octet.
+    if (num_fields > size - offset) {
+        throw msgpack::insufficient_bytes("insufficient bytes");
+    }
+
+    std::vector<packed_field> packed_fields;
+    packed_fields.reserve(num_fields);
+    for (std::size_t index = 0; index < num_fields; ++index) {
+        const std::size_t end = skip_object(data, size, offset);
+        packed_fields.push_back(packed_field{offset, end - offset, false});
+        offset = end;
+    }
+
+    if (offset != size) {
+        throw msgpack::parse_error("trailing bytes after message");
+    }
+
+    m_fields.resize(num_fields);
+    m_packed_fields = std::move(packed_fields);
+}
+
+inline void wamp_message::decode_field(std::size_t index) const
+{
+    if (index >= m_packed_fields.size() || m_packed_fields[index].decoded) {
+        return;
+    }
+
+    // Payloads reference the packed message instead of being copied.
+    const packed_field& packed = m_packed_fields[index];
+    std::size_t offset = packed.offset;
+    bool referenced = false;
+    m_fields[index] = msgpack::unpack(m_zone, m_encoded->data(), packed.offset + packed.size,
+            offset, referenced, &wamp_message::reference_field, nullptr);
+    m_packed_fields[index].decoded = true;
+}
+
+inline void wamp_message::release_encoded()
+{
+    index_fields();
+    if (m_packed_fields.empty()) {
+        return;
+    }
+
+    for (std::size_t index = 0; index < m_packed_fields.size(); ++index) {
+        decode_field(index);
+    }
+
+    m_packed_fields.clear();
+    m_zone.push_finalizer(std::move(m_encoded));
+}
+
+inline void wamp_message::materialize_fields()
+{
+    release_encoded();
+    if (m_field_view) {
+        m_fields.assign(m_field_view, m_field_view + m_field_view_size);
+        m_field_view = nullptr;
+        m_field_view_size = 0;
+    }
+
+    // The packed message no longer reflects fields that can be modified.
+    m_encoded.reset();
+}
+
+inline std::size_t wamp_message::skip_object(const char* data, std::size_t size, std::size_t offset)
+{
+    // Reads a big endian length of the given number of octets.
+    auto read_length = [&](std::size_t length) {
+        if (size - offset < length) {
+            throw msgpack::insufficient_bytes("insufficient bytes");
+        }
+        std::size_t value = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            value = (value << 8) | static_cast<uint8_t>(data[offset++]);
+        }
+        return value;
+    };
+
+    // The number of objects that still have to be skipped, containers
+    // add their elements to it.
+    std::size_t pending = 1;
+    while (pending > 0) {
+        --pending;
+        if (offset >= size) {
+            throw msgpack::insufficient_bytes("insufficient bytes");
+        }
+
+        const uint8_t header = static_cast<uint8_t>(data[offset++]);
+        std::size_t body = 0;
+        if (header <= 0x7f || header >= 0xe0) {
+            // fixint
+        } else if (header <= 0x8f) {
+            pending += 2 * (header & 0x0f);
+        } else if (header <= 0x9f) {
+            pending += header & 0x0f;
+        } else if (header <= 0xbf) {
+            body = header & 0x1f;
+        } else {
+            switch (header) {
+                case 0xc0: case 0xc2: case 0xc3: break;
+                case 0xc4: case 0xd9: body = read_length(1); break;
+                case 0xc5: case 0xda: body = read_length(2); break;
+                case 0xc6: case 0xdb: body = read_length(4); break;
+                case 0xc7: body = read_length(1) + 1; break;
+                case 0xc8: body = read_length(2) + 1; break;
+                case 0xc9: body = read_length(4) + 1; break;
+                case 0xcc: case 0xd0: body = 1; break;
+                case 0xcd: case 0xd1: body = 2; break;
+                case 0xca: case 0xce: case 0xd2: body = 4; break;
+                case 0xcb: case 0xcf: case 0xd3: body = 8; break;
+                case 0xd4: body = 2; break;
+                case 0xd5: body = 3; break;
+                case 0xd6: body = 5; break;
+                case 0xd7: body = 9; break;
+                case 0xd8: body = 17; break;
+                case 0xdc: pending += read_length(2); break;
+                case 0xdd: pending += read_length(4); break;
+                case 0xde: pending += 2 * read_length(2); break;
+                case 0xdf: pending += 2 * read_length(4); break;
+                default: throw msgpack::parse_error("invalid msgpack type");
+            }
+        }
+
+        if (size - offset < body || size - offset - body < pending) {
+            throw msgpack::insufficient_bytes("insufficient bytes");
+        }
+        offset += body;
+    }
+
+    return offset;
+}
+
+inline bool wamp_message::reference_field(
+        msgpack::type::object_type /* type */, std::size_t /* length */, void* /* user_data */)
+{
+    return true;
+}
+
 inline std::ostream& operator<<(std::ostream& os, const wamp_message& message)
 {
     std::size_t num_fields = message.size();
@@ -150,3 +510,29 @@ inline std::ostream& operator<<(std::ostream& os, const wamp_message& message)
 }
 
 } // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template<>
+struct pack<autobahn::wamp_message>
+{
+    template <typename Stream>
+    msgpack::packer<Stream>& operator()(
+            msgpack::packer<Stream>& packer,
+            autobahn::wamp_message const& message) const
+    {
+        const std::size_t num_fields = message.size();
+        packer.pack_array(static_cast<uint32_t>(num_fields));
+        for (std::size_t index = 0; index < num_fields; ++index) {
+            packer.pack(message.field(index));
+        }
+
+        return packer;
+    }
+};
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
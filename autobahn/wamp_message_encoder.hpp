@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_MESSAGE_ENCODER_HPP
+#define AUTOBAHN_WAMP_MESSAGE_ENCODER_HPP
+
+#include "wamp_call_options.hpp"
+#include "wamp_message.hpp"
+#include "wamp_publish_options.hpp"
+#include "wamp_raw_payload.hpp"
+#include "wamp_subscribe_options.hpp"
+#include "wamp_uri.hpp"
+#include "wamp_zone_pool.hpp"
+
+#include <memory>
+#include <msgpack.hpp>
+
+namespace autobahn {
+
+/*!
+ * Encodes a wamp message by packing the given fields straight into a
+ * msgpack buffer, in a single pass. This avoids converting each field
+ * into a zone allocated msgpack object first, which is what set_field()
+ * does.
+ *
+ *     encode_wamp_message(static_cast<int>(message_type::PUBLISH),
+ *             request_id, options, topic, arguments);
+ *
+ * A wamp_raw_payload passed as the last field adds as many fields as it
+ * has packed.
+ *
+ * @tparam Fields The field types. Each needs a msgpack pack adaptor.
+ * @param fields The message fields, in order.
+ *
+ * @return The encoded message.
+ */
+template <typename... Fields>
+wamp_message encode_wamp_message(const Fields&... fields);
+
+/*!
+ * Encodes a wamp message as above, into a buffer and a zone borrowed
+ * from a pool. The session encodes the messages it sends this way, so
+ * that they do not allocate in steady state.
+ *
+ * @param zone_pool The pool to borrow the buffer and the zone from.
+ * @param fields The message fields, in order.
+ *
+ * @return The encoded message.
+ */
+template <typename... Fields>
+wamp_message encode_wamp_message(
+        const std::shared_ptr<wamp_zone_pool>& zone_pool, const Fields&... fields);
+
+/*!
+ * Packs the given fields as a msgpack array into a buffer.
+ */
+template <typename... Fields>
+void encode_wamp_fields(msgpack::sbuffer& buffer, const Fields&... fields);
+
+/*!
+ * Packs a single message field. Fields that are already packed, such as
+ * a wamp_uri or the options, are copied into the buffer as they are.
+ */
+template <typename Field>
+void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& packer, msgpack::sbuffer& buffer, const Field& field);
+
+void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& packer, msgpack::sbuffer& buffer, const wamp_uri& uri);
+
+void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& packer, msgpack::sbuffer& buffer, const wamp_call_options& options);
+
+void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& packer, msgpack::sbuffer& buffer, const wamp_publish_options& options);
+
+void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& packer, msgpack::sbuffer& buffer, const wamp_subscribe_options& options);
+
+void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& packer, msgpack::sbuffer& buffer, const wamp_raw_payload& payload);
+
+/*!
+ * The number of message fields that a field contributes, which is one
+ * for all but a wamp_raw_payload.
+ */
+template <typename Field>
+std::size_t count_wamp_fields(const Field& field);
+
+std::size_t count_wamp_fields(const wamp_raw_payload& payload);
+
+} // namespace autobahn
+
+#include "wamp_message_encoder.ipp"
+
+#endif // AUTOBAHN_WAMP_MESSAGE_ENCODER_HPP
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+#include <msgpack/pack.hpp>
+#include <msgpack/sbuffer.hpp>
+
+namespace autobahn {
+
+template <typename Field>
+inline void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& packer, msgpack::sbuffer& /* buffer */, const Field& field)
+{
+    packer.pack(field);
+}
+
+inline void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& /* packer */, msgpack::sbuffer& buffer, const wamp_uri& uri)
+{
+    // The packer does not buffer, so the packed URI can be written straight
+    // into the buffer in between the packed fields.
+    buffer.write(uri.packed().data(), uri.packed().size());
+}
+
+inline void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& /* packer */, msgpack::sbuffer& buffer, const wamp_call_options& options)
+{
+    buffer.write(options.packed().data(), options.packed().size());
+}
+
+inline void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& /* packer */, msgpack::sbuffer& buffer, const wamp_publish_options& options)
+{
+    buffer.write(options.packed().data(), options.packed().size());
+}
+
+inline void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& /* packer */, msgpack::sbuffer& buffer, const wamp_subscribe_options& options)
+{
+    buffer.write(options.packed().data(), options.packed().size());
+}
+
+inline void encode_wamp_field(
+        msgpack::packer<msgpack::sbuffer>& /* packer */, msgpack::sbuffer& buffer, const wamp_raw_payload& payload)
+{
+    if (payload.size() > 0) {
+        buffer.write(payload.data(), payload.size());
+    }
+}
+
+template <typename Field>
+inline std::size_t count_wamp_fields(const Field& /* field */)
+{
+    return 1;
+}
+
+inline std::size_t count_wamp_fields(const wamp_raw_payload& payload)
+{
+    return payload.num_fields();
+}
+
+template <typename... Fields>
+inline void encode_wamp_fields(msgpack::sbuffer& buffer, const Fields&... fields)
+{
+    msgpack::packer<msgpack::sbuffer> packer(buffer);
+
+    // Expanding the packs into initializer lists visits the fields in order.
+    std::size_t num_fields = 0;
+    int count[] = { 0, (num_fields += count_wamp_fields(fields), 0)... };
+    (void) count;
+
+    packer.pack_array(static_cast<uint32_t>(num_fields));
+
+    int expand[] = { 0, (encode_wamp_field(packer, buffer, fields), 0)... };
+    (void) expand;
+}
+
+template <typename... Fields>
+inline wamp_message encode_wamp_message(const Fields&... fields)
+{
+    std::unique_ptr<msgpack::sbuffer> buffer(new msgpack::sbuffer(256));
+    encode_wamp_fields(*buffer, fields...);
+
+    return wamp_message(std::move(buffer));
+}
+
+template <typename... Fields>
+inline wamp_message encode_wamp_message(
+        const std::shared_ptr<wamp_zone_pool>& zone_pool, const Fields&... fields)
+{
+    std::unique_ptr<msgpack::sbuffer> buffer = zone_pool->acquire_buffer();
+    encode_wamp_fields(*buffer, fields...);
+
+    return wamp_message(std::move(buffer), zone_pool);
+}
+
+} // namespace autobahn
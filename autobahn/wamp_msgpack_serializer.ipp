@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "exceptions.hpp"
+#include "wamp_message.hpp"
+
+#include <msgpack.hpp>
+
+namespace autobahn {
+
+inline const char* wamp_msgpack_serializer::name() const
+{
+    return "msgpack";
+}
+
+inline const char* wamp_msgpack_serializer::subprotocol() const
+{
+    return "wamp.2.msgpack";
+}
+
+inline wamp_rawsocket_serializer wamp_msgpack_serializer::rawsocket_id() const
+{
+    return wamp_rawsocket_serializer::msgpack;
+}
+
+inline bool wamp_msgpack_serializer::is_binary() const
+{
+    return true;
+}
+
+inline void wamp_msgpack_serializer::serialize(
+        const wamp_message& message, msgpack::sbuffer& buffer) const
+{
+    if (message.is_encoded()) {
+        buffer.write(message.encoded().data(), message.encoded().size());
+        return;
+    }
+
+    msgpack::packer<msgpack::sbuffer> packer(buffer);
+    packer.pack(message);
+}
+
+inline wamp_message wamp_msgpack_serializer::deserialize(
+        const char* data, std::size_t length) const
+{
+    std::size_t offset = 0;
+    msgpack::unpacked result;
+
+    try {
+        result = msgpack::unpack(data, length, offset);
+    } catch (const msgpack::unpack_error& e) {
+        throw protocol_error(e.what());
+    }
+
+    if (offset != length || result.get().type != msgpack::type::ARRAY) {
+        throw protocol_error("invalid msgpack message");
+    }
+
+    return wamp_message(result.get(), std::move(*(result.zone())));
+}
+
+} // namespace autobahn
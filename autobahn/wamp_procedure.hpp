@@ -34,11 +34,25 @@
 #include "wamp_arguments.hpp"
 #include "wamp_invocation.hpp"
 
+#include <boost/asio/detail/config.hpp>
+
+#include <functional>
+#include <utility>
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+#include <boost/asio/awaitable.hpp>
+#endif
+
 namespace autobahn {
 
 /// Handler type for use with wamp_session::provide
 using wamp_procedure = std::function<void(wamp_invocation)>;
 
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+/// Coroutine handler type for use with wamp_session::async_provide_coroutine
+using wamp_coroutine_procedure = std::function<boost::asio::awaitable<void>(wamp_invocation)>;
+#endif
+
 using provide_options = wamp_kw_arguments;
 
 } // namespace autobahn
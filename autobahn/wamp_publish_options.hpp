@@ -32,6 +32,7 @@
 #define AUTOBAHN_WAMP_PUBLISH_OPTIONS_HPP
 
 #include <chrono>
+#include <string>
 
 namespace autobahn {
 
@@ -54,8 +55,17 @@ public:
 
     void set_exclude_me(const bool& exclude_me);
 
+    /*!
+     * The options packed as a msgpack map. The packed options are kept
+     * up to date by the setters so that messages can copy them as they are.
+     */
+    const std::string& packed() const;
+
 private:
+    void update_packed();
+
     bool m_exclude_me;
+    std::string m_packed;
 };
 
 } // namespace autobahn
@@ -36,6 +36,7 @@ namespace autobahn {
 
 inline wamp_publish_options::wamp_publish_options()
     : m_exclude_me(true) //default
+    , m_packed("\x80", 1) // empty map
 {
 }
 
@@ -47,6 +48,12 @@ inline const bool& wamp_publish_options::exclude_me() const
 inline void wamp_publish_options::set_exclude_me(const bool& exclude_me)
 {
     m_exclude_me = exclude_me;
+    update_packed();
+}
+
+inline const std::string& wamp_publish_options::packed() const
+{
+    return m_packed;
 }
 
 } // namespace autobahn
@@ -82,13 +89,16 @@ struct pack<autobahn::wamp_publish_options>
             msgpack::packer<Stream>& packer,
             autobahn::wamp_publish_options const& options) const
     {
-        std::unordered_map<std::string, unsigned> options_map;
         const auto& exclude_me = options.exclude_me();
-        if (exclude_me != true) { //true is default, only false msut be transfered
-            options_map["exclude_me"] = exclude_me;
+        if (exclude_me) { //true is default, only false must be transfered
+            packer.pack_map(0);
+            return packer;
         }
 
-        packer.pack(options_map);
+        packer.pack_map(1);
+        packer.pack_str(10);
+        packer.pack_str_body("exclude_me", 10);
+        packer.pack_false();
 
         return packer;
     }
@@ -115,3 +125,14 @@ struct object_with_zone<autobahn::wamp_publish_options>
 } // namespace adaptor
 } // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
 } // namespace msgpack
+
+namespace autobahn {
+
+inline void wamp_publish_options::update_packed()
+{
+    msgpack::sbuffer buffer(16);
+    msgpack::pack(buffer, *this);
+    m_packed.assign(buffer.data(), buffer.size());
+}
+
+} // namespace autobahn
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_RAW_PAYLOAD_HPP
+#define AUTOBAHN_WAMP_RAW_PAYLOAD_HPP
+
+#include <msgpack.hpp>
+
+#include <cstddef>
+
+namespace autobahn {
+
+/*!
+ * The Arguments and ArgumentsKw of a message in their packed msgpack form.
+ * A relay uses it to pass the arguments of a received event, call result or
+ * invocation on to another message without unpacking and repacking them.
+ *
+ *     other_session->publish(topic, event->raw_payload());
+ *
+ * The payload does not own the packed bytes. They belong to the object the
+ * payload was taken from, or to the caller for a payload that the caller
+ * has packed itself, and must outlive the payload.
+ */
+class wamp_raw_payload
+{
+public:
+    /*!
+     * Constructs a payload without any arguments.
+     */
+    wamp_raw_payload();
+
+    /*!
+     * Constructs a payload from packed fields. Throws an exception if
+     * there are more than two fields.
+     *
+     * @param data The packed Arguments list, optionally followed by the
+     *             packed ArgumentsKw dict.
+     * @param size The number of packed octets.
+     * @param num_fields The number of packed fields.
+     */
+    wamp_raw_payload(const char* data, std::size_t size, std::size_t num_fields);
+
+    /*!
+     * The packed fields.
+     */
+    const char* data() const;
+
+    /*!
+     * The number of packed octets.
+     */
+    std::size_t size() const;
+
+    /*!
+     * The number of packed fields: zero, one for just the Arguments or
+     * two for the Arguments and the ArgumentsKw.
+     */
+    std::size_t num_fields() const;
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+    std::size_t m_num_fields;
+};
+
+/*!
+ * Packs unpacked arguments into the given buffer, for objects whose
+ * arguments are not available in packed form.
+ *
+ * @param arguments The positional arguments.
+ * @param kw_arguments The keyword arguments.
+ * @param buffer The buffer to pack into, which the payload references.
+ *
+ * @return The packed payload.
+ */
+wamp_raw_payload pack_wamp_raw_payload(
+        const msgpack::object& arguments,
+        const msgpack::object& kw_arguments,
+        msgpack::sbuffer& buffer);
+
+} // namespace autobahn
+
+#include "wamp_raw_payload.ipp"
+
+#endif // AUTOBAHN_WAMP_RAW_PAYLOAD_HPP
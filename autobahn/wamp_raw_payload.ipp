@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+namespace autobahn {
+
+inline wamp_raw_payload::wamp_raw_payload()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_num_fields(0)
+{
+}
+
+inline wamp_raw_payload::wamp_raw_payload(
+        const char* data, std::size_t size, std::size_t num_fields)
+    : m_data(data)
+    , m_size(size)
+    , m_num_fields(num_fields)
+{
+    if (num_fields > 2) {
+        throw std::invalid_argument("a raw payload holds at most two fields");
+    }
+}
+
+inline const char* wamp_raw_payload::data() const
+{
+    return m_data;
+}
+
+inline std::size_t wamp_raw_payload::size() const
+{
+    return m_size;
+}
+
+inline std::size_t wamp_raw_payload::num_fields() const
+{
+    return m_num_fields;
+}
+
+inline wamp_raw_payload pack_wamp_raw_payload(
+        const msgpack::object& arguments,
+        const msgpack::object& kw_arguments,
+        msgpack::sbuffer& buffer)
+{
+    // Empty trailing fields are left out, as they would be on the wire.
+    std::size_t num_fields = 0;
+    if (kw_arguments.type == msgpack::type::MAP && kw_arguments.via.map.size > 0) {
+        num_fields = 2;
+    } else if (arguments.type == msgpack::type::ARRAY && arguments.via.array.size > 0) {
+        num_fields = 1;
+    }
+
+    msgpack::packer<msgpack::sbuffer> packer(buffer);
+    if (num_fields > 0) {
+        packer.pack(arguments);
+    }
+    if (num_fields > 1) {
+        packer.pack(kw_arguments);
+    }
+
+    return wamp_raw_payload(buffer.data(), buffer.size(), num_fields);
+}
+
+} // namespace autobahn
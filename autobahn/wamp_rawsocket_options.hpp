@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_RAWSOCKET_OPTIONS_HPP
+#define AUTOBAHN_WAMP_RAWSOCKET_OPTIONS_HPP
+
+#include "wamp_serializer.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * Tuning options for a rawsocket transport.
+ */
+class wamp_rawsocket_options
+{
+public:
+    wamp_rawsocket_options();
+
+    /*!
+     * The maximum number of octets that are gathered into a single write.
+     * A message that is larger than this limit is still written on its own.
+     */
+    std::size_t max_coalesced_bytes() const;
+    void set_max_coalesced_bytes(std::size_t max_coalesced_bytes);
+
+    /*!
+     * The maximum number of messages that are gathered into a single write.
+     */
+    std::size_t max_coalesced_messages() const;
+    void set_max_coalesced_messages(std::size_t max_coalesced_messages);
+
+    /*!
+     * How long queued messages may be held back waiting for more messages
+     * before they are flushed. A delay of zero flushes the queued messages
+     * once the messages sent during the current io_service tick have been
+     * queued.
+     */
+    const std::chrono::microseconds& max_coalescing_delay() const;
+    void set_max_coalescing_delay(const std::chrono::microseconds& max_coalescing_delay);
+
+    /*!
+     * When the number of octets waiting in the write queue reaches the high
+     * watermark, the transport invokes its pause handler so that the
+     * application stops producing messages. A high watermark of zero
+     * disables this. Throws an std::invalid_argument if a non zero high
+     * watermark is below the low watermark, so lowering both has to start
+     * with the low watermark. Defaults to 4 MiB.
+     */
+    std::size_t high_watermark() const;
+    void set_high_watermark(std::size_t high_watermark);
+
+    /*!
+     * Once the write queue of a paused transport has drained to the low
+     * watermark, the transport invokes its resume handler. Throws an
+     * std::invalid_argument if it exceeds a non zero high watermark.
+     * Defaults to 1 MiB.
+     */
+    std::size_t low_watermark() const;
+    void set_low_watermark(std::size_t low_watermark);
+
+    /*!
+     * Received STR and BIN payloads of at least this many octets are not
+     * copied into the message zone but reference the receive buffer, which
+     * is then kept alive for as long as the message zone. A threshold of
+     * zero copies all payloads.
+     */
+    std::size_t reference_threshold() const;
+    void set_reference_threshold(std::size_t reference_threshold);
+
+    /*!
+     * Whether or not received msgpack EVENT, RESULT and INVOCATION messages
+     * are decoded lazily. A lazily decoded message is copied out of the
+     * receive buffer and its fields are only unpacked once they are
+     * accessed, with their payloads referencing the copy. Its packed
+     * arguments are kept, so that they can be passed on as a raw payload
+     * without being packed again. All other messages are unpacked in
+     * place. The reference threshold only applies to messages that are
+     * decoded eagerly. Off by default, since the copy costs an allocation
+     * per message that in place unpacking avoids.
+     */
+    bool lazy_decoding() const;
+    void set_lazy_decoding(bool lazy_decoding);
+
+    /*!
+     * The number of octets requested from the socket per read. All
+     * complete frames that a read delivers are processed before the next
+     * read is started.
+     */
+    std::size_t read_size() const;
+    void set_read_size(std::size_t read_size);
+
+    /*!
+     * The maximum message length that is advertised to the peer during the
+     * handshake. Rawsocket can only express powers of two between 2^9 and
+     * 2^24 octets, so the length is rounded down to a power of two. Throws
+     * an exception if the length is outside of that range.
+     */
+    std::size_t max_receive_length() const;
+    void set_max_receive_length(std::size_t max_receive_length);
+
+    /*!
+     * The serializers to offer to the peer, in order of preference. When the
+     * peer rejects a serializer, the transport reconnects and offers the
+     * next one.
+     */
+    const std::vector<wamp_rawsocket_serializer>& serializers() const;
+    void set_serializers(const std::vector<wamp_rawsocket_serializer>& serializers);
+
+    /*!
+     * The steady state capacity of the receive buffer. The buffer grows to
+     * fit frames that are larger than this and is shrunk back afterwards.
+     */
+    std::size_t receive_buffer_size() const;
+    void set_receive_buffer_size(std::size_t receive_buffer_size);
+
+    /*!
+     * How often the transport sends a rawsocket PING to the peer. An
+     * interval of zero disables sending PINGs. PINGs from the peer are
+     * always answered.
+     */
+    const std::chrono::milliseconds& ping_interval() const;
+    void set_ping_interval(const std::chrono::milliseconds& ping_interval);
+
+    /*!
+     * How long the transport waits for the PONG to one of its PINGs before
+     * it considers the peer dead and closes the connection.
+     */
+    const std::chrono::milliseconds& ping_timeout() const;
+    void set_ping_timeout(const std::chrono::milliseconds& ping_timeout);
+
+    /*!
+     * The maximum number of send buffers kept for reuse once they have
+     * been written.
+     */
+    std::size_t max_pooled_send_buffers() const;
+    void set_max_pooled_send_buffers(std::size_t max_pooled_send_buffers);
+
+    /*!
+     * Send buffers that held a frame larger than this are released instead
+     * of being kept for reuse.
+     */
+    std::size_t max_pooled_send_buffer_size() const;
+    void set_max_pooled_send_buffer_size(std::size_t max_pooled_send_buffer_size);
+
+private:
+    std::size_t m_max_coalesced_bytes;
+    std::size_t m_max_coalesced_messages;
+    std::chrono::microseconds m_max_coalescing_delay;
+    std::size_t m_high_watermark;
+    std::size_t m_low_watermark;
+    std::size_t m_reference_threshold;
+    bool m_lazy_decoding;
+    std::size_t m_read_size;
+    std::size_t m_max_receive_length;
+    std::vector<wamp_rawsocket_serializer> m_serializers;
+    std::size_t m_receive_buffer_size;
+    std::chrono::milliseconds m_ping_interval;
+    std::chrono::milliseconds m_ping_timeout;
+    std::size_t m_max_pooled_send_buffers;
+    std::size_t m_max_pooled_send_buffer_size;
+};
+
+} // namespace autobahn
+
+#include "wamp_rawsocket_options.ipp"
+
+#endif // AUTOBAHN_WAMP_RAWSOCKET_OPTIONS_HPP
@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "wamp_transport.hpp"
+
+#include <stdexcept>
+
+namespace autobahn {
+
+inline wamp_rawsocket_options::wamp_rawsocket_options()
+    : m_max_coalesced_bytes(64 * 1024)
+    , m_max_coalesced_messages(64)
+    , m_max_coalescing_delay(0)
+    , m_high_watermark(DEFAULT_SEND_HIGH_WATERMARK)
+    , m_low_watermark(DEFAULT_SEND_LOW_WATERMARK)
+    , m_reference_threshold(256)
+    , m_lazy_decoding(false)
+    , m_read_size(64 * 1024)
+    , m_max_receive_length(1 << 24)
+    , m_serializers({ wamp_rawsocket_serializer::msgpack })
+    , m_receive_buffer_size(64 * 1024)
+    , m_ping_interval(0)
+    , m_ping_timeout(10000)
+    , m_max_pooled_send_buffers(64)
+    , m_max_pooled_send_buffer_size(64 * 1024)
+{
+}
+
+inline std::size_t wamp_rawsocket_options::max_coalesced_bytes() const
+{
+    return m_max_coalesced_bytes;
+}
+
+inline void wamp_rawsocket_options::set_max_coalesced_bytes(std::size_t max_coalesced_bytes)
+{
+    m_max_coalesced_bytes = max_coalesced_bytes;
+}
+
+inline std::size_t wamp_rawsocket_options::max_coalesced_messages() const
+{
+    return m_max_coalesced_messages;
+}
+
+inline void wamp_rawsocket_options::set_max_coalesced_messages(std::size_t max_coalesced_messages)
+{
+    m_max_coalesced_messages = max_coalesced_messages;
+}
+
+inline const std::chrono::microseconds& wamp_rawsocket_options::max_coalescing_delay() const
+{
+    return m_max_coalescing_delay;
+}
+
+inline void wamp_rawsocket_options::set_max_coalescing_delay(
+        const std::chrono::microseconds& max_coalescing_delay)
+{
+    m_max_coalescing_delay = max_coalescing_delay;
+}
+
+inline std::size_t wamp_rawsocket_options::high_watermark() const
+{
+    return m_high_watermark;
+}
+
+inline void wamp_rawsocket_options::set_high_watermark(std::size_t high_watermark)
+{
+    if (high_watermark != 0 && high_watermark < m_low_watermark) {
+        throw std::invalid_argument("rawsocket high watermark must not be below the low watermark");
+    }
+
+    m_high_watermark = high_watermark;
+}
+
+inline std::size_t wamp_rawsocket_options::low_watermark() const
+{
+    return m_low_watermark;
+}
+
+inline void wamp_rawsocket_options::set_low_watermark(std::size_t low_watermark)
+{
+    if (m_high_watermark != 0 && low_watermark > m_high_watermark) {
+        throw std::invalid_argument("rawsocket low watermark must not exceed the high watermark");
+    }
+
+    m_low_watermark = low_watermark;
+}
+
+inline std::size_t wamp_rawsocket_options::reference_threshold() const
+{
+    return m_reference_threshold;
+}
+
+inline void wamp_rawsocket_options::set_reference_threshold(std::size_t reference_threshold)
+{
+    m_reference_threshold = reference_threshold;
+}
+
+inline bool wamp_rawsocket_options::lazy_decoding() const
+{
+    return m_lazy_decoding;
+}
+
+inline void wamp_rawsocket_options::set_lazy_decoding(bool lazy_decoding)
+{
+    m_lazy_decoding = lazy_decoding;
+}
+
+inline std::size_t wamp_rawsocket_options::read_size() const
+{
+    return m_read_size;
+}
+
+inline void wamp_rawsocket_options::set_read_size(std::size_t read_size)
+{
+    m_read_size = read_size;
+}
+
+inline std::size_t wamp_rawsocket_options::max_receive_length() const
+{
+    return m_max_receive_length;
+}
+
+inline void wamp_rawsocket_options::set_max_receive_length(std::size_t max_receive_length)
+{
+    if (max_receive_length < (1 << 9) || max_receive_length > (1 << 24)) {
+        throw std::invalid_argument("rawsocket max receive length must be between 2^9 and 2^24 octets");
+    }
+
+    std::size_t length = 1 << 9;
+    while (length * 2 <= max_receive_length) {
+        length *= 2;
+    }
+
+    m_max_receive_length = length;
+}
+
+inline const std::vector<wamp_rawsocket_serializer>& wamp_rawsocket_options::serializers() const
+{
+    return m_serializers;
+}
+
+inline void wamp_rawsocket_options::set_serializers(
+        const std::vector<wamp_rawsocket_serializer>& serializers)
+{
+    if (serializers.empty()) {
+        throw std::invalid_argument("at least one rawsocket serializer is required");
+    }
+
+    m_serializers = serializers;
+}
+
+inline std::size_t wamp_rawsocket_options::receive_buffer_size() const
+{
+    return m_receive_buffer_size;
+}
+
+inline void wamp_rawsocket_options::set_receive_buffer_size(std::size_t receive_buffer_size)
+{
+    m_receive_buffer_size = receive_buffer_size;
+}
+
+inline const std::chrono::milliseconds& wamp_rawsocket_options::ping_interval() const
+{
+    return m_ping_interval;
+}
+
+inline void wamp_rawsocket_options::set_ping_interval(const std::chrono::milliseconds& ping_interval)
+{
+    m_ping_interval = ping_interval;
+}
+
+inline const std::chrono::milliseconds& wamp_rawsocket_options::ping_timeout() const
+{
+    return m_ping_timeout;
+}
+
+inline void wamp_rawsocket_options::set_ping_timeout(const std::chrono::milliseconds& ping_timeout)
+{
+    m_ping_timeout = ping_timeout;
+}
+
+inline std::size_t wamp_rawsocket_options::max_pooled_send_buffers() const
+{
+    return m_max_pooled_send_buffers;
+}
+
+inline void wamp_rawsocket_options::set_max_pooled_send_buffers(std::size_t max_pooled_send_buffers)
+{
+    m_max_pooled_send_buffers = max_pooled_send_buffers;
+}
+
+inline std::size_t wamp_rawsocket_options::max_pooled_send_buffer_size() const
+{
+    return m_max_pooled_send_buffer_size;
+}
+
+inline void wamp_rawsocket_options::set_max_pooled_send_buffer_size(std::size_t max_pooled_send_buffer_size)
+{
+    m_max_pooled_send_buffer_size = max_pooled_send_buffer_size;
+}
+
+} // namespace autobahn
@@ -32,12 +32,21 @@
 #define AUTOBAHN_WAMP_NETWORK_TRANSPORT_HPP
 
 #include "boost_config.hpp"
+#include "wamp_buffer_pool.hpp"
+#include "wamp_rawsocket_options.hpp"
 #include "wamp_transport.hpp"
 
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
 #include <cstddef>
+#include <deque>
 #include <memory>
+#include <msgpack/sbuffer.hpp>
 #include <msgpack/unpack.hpp>
+#include <string>
+#include <vector>
 
 namespace autobahn {
 
@@ -73,11 +82,14 @@ public:
      *
      * @param io_service The io service to use for asynchronous operations.
      * @param remote_endpoint The remote endpoint to connect to.
+     * @param debug_enabled Whether or not to log debug output.
+     * @param options The tuning options for the transport.
      */
     wamp_rawsocket_transport(
             boost::asio::io_service& io_service,
             const endpoint_type& remote_endpoint,
-            bool debug_enabled=false);
+            bool debug_enabled=false,
+            const wamp_rawsocket_options& options=wamp_rawsocket_options());
 
     virtual ~wamp_rawsocket_transport() override = default;
 
@@ -123,7 +135,9 @@ public:
     /*!
      * Pause receiving of messages. This will prevent the transport from receiving
      * any more messages until it has been resumed. This is used to excert
-     * backpressure on the sending peer.
+     * backpressure on the sending peer. A message that is already being
+     * received is still delivered. The PONG timeout is suspended until
+     * receiving resumes.
      */
     virtual void pause() override;
 
@@ -149,26 +163,88 @@ public:
      */
     virtual bool has_handler() const override;
 
+    /*
+     * ROUND TRIP TIME
+     */
+    /*!
+     * The round trip time measured by the most recent PING/PONG exchange,
+     * or zero if no PONG has been received yet. Round trip times are only
+     * measured when a ping interval has been configured.
+     */
+    std::chrono::microseconds round_trip_time() const;
+
+    /*!
+     * The exponentially weighted moving average of the measured round
+     * trip times.
+     */
+    std::chrono::microseconds average_round_trip_time() const;
+
+    /*!
+     * The 99th percentile of the most recently measured round trip times.
+     */
+    std::chrono::microseconds p99_round_trip_time() const;
+
 protected:
     socket_type& socket();
 
 private:
+    void connect_socket();
+
+    bool select_serializer(std::size_t index);
+
+    static bool reference_payload(
+            msgpack::type::object_type type,
+            std::size_t length,
+            void* user_data);
 
     void handshake_reply_handler(
             const boost::system::error_code& error_code,
             std::size_t /* bytes_transferred */);
 
+    void schedule_flush();
+
+    void flush_handler(const boost::system::error_code& error_code);
+
+    void queue_frame(std::shared_ptr<msgpack::sbuffer>&& frame);
+
+    void send_control_frame(uint8_t frame_type, const char* payload, std::size_t length);
+
+    void send_queued_messages();
+
+    void send_message_handler(
+            const boost::system::error_code& error_code,
+            std::size_t /* bytes_transferred */);
+
+    void check_watermarks();
+
     void receive_message();
 
-    void receive_message_header(
-            const boost::system::error_code& error,
-            std::size_t /* bytes transferred */);
+    void receive_handler(
+            const boost::system::error_code& error_code,
+            std::size_t bytes_transferred);
+
+    bool receive_frames();
+
+    void shrink_receive_buffer();
+
+    void fail_connection(const std::string& reason);
+
+    void receive_pong(const char* payload, std::size_t length);
+
+    void start_ping_timer();
 
-    void receive_message_body(
-            const boost::system::error_code& error,
-            std::size_t /* bytes transferred */);
+    void ping_handler(const boost::system::error_code& error_code);
+
+    void start_pong_timer();
+
+    void pong_timeout_handler(const boost::system::error_code& error_code);
 
 private:
+    /*!
+     * The io service used for deferring writes.
+     */
+    boost::asio::io_service& m_io_service;
+
     /*!
      * The underlying socket for the transport.
      */
@@ -215,10 +291,151 @@ private:
     uint32_t m_message_length;
 
     /*!
-     * Used for unpacking serialized messages.
+     * Whether or not the header of the next message has been received.
+     */
+    bool m_message_header_received;
+
+    /*!
+     * The type of the frame whose header has been received.
+     */
+    uint8_t m_frame_type;
+
+    /*!
+     * Whether or not the receive buffer has been grown beyond its steady
+     * state size to fit a large frame.
+     */
+    bool m_receive_buffer_grown;
+
+    /*!
+     * Used for unpacking serialized messages. Its buffer also serves as
+     * the receive buffer that the socket reads into.
      */
     msgpack::unpacker m_message_unpacker;
 
+    /*!
+     * Framed messages waiting to be written. Each buffer holds the 4-byte
+     * length prefix followed by the serialized message. The buffer at the
+     * front of the queue is the one being written while a write is in progress.
+     */
+    std::deque<std::shared_ptr<msgpack::sbuffer>> m_write_queue;
+
+    /*!
+     * Buffers that have been written and can be reused for framing
+     * further messages.
+     */
+    wamp_buffer_pool m_send_buffers;
+
+    /*!
+     * The total number of octets held in the write queue.
+     */
+    std::size_t m_write_queue_bytes;
+
+    /*!
+     * The buffers of the messages gathered into the write that is currently
+     * in progress. Kept as a member so that its storage is reused.
+     */
+    std::vector<boost::asio::const_buffer> m_write_buffers;
+
+    /*!
+     * Whether or not an asynchronous write is currently in progress.
+     */
+    bool m_write_in_progress;
+
+    /*!
+     * Whether or not the pause handler has been invoked because the write
+     * queue reached the high watermark.
+     */
+    bool m_send_paused;
+
+    /*!
+     * Whether or not receiving has been paused.
+     */
+    bool m_receive_paused;
+
+    /*!
+     * Whether or not a read has been held back while receiving is paused.
+     */
+    bool m_receive_deferred;
+
+    /*!
+     * Whether or not a flush of the write queue has been scheduled.
+     */
+    bool m_flush_pending;
+
+    /*!
+     * Timer used to hold back queued messages for the configured
+     * coalescing delay.
+     */
+    boost::asio::steady_timer m_flush_timer;
+
+    /*!
+     * The tuning options for the transport.
+     */
+    wamp_rawsocket_options m_options;
+
+    /*!
+     * Timer used for sending periodic PINGs.
+     */
+    boost::asio::steady_timer m_ping_timer;
+
+    /*!
+     * Timer used for detecting a PONG that fails to arrive.
+     */
+    boost::asio::steady_timer m_pong_timer;
+
+    /*!
+     * The sequence number carried by the most recently sent PING.
+     */
+    uint64_t m_ping_sequence;
+
+    /*!
+     * Whether or not the PONG to the most recently sent PING is outstanding.
+     */
+    bool m_ping_outstanding;
+
+    /*!
+     * When the most recently sent PING was queued.
+     */
+    std::chrono::steady_clock::time_point m_ping_sent;
+
+    /*!
+     * The most recently measured round trip time.
+     */
+    std::chrono::microseconds m_round_trip_time;
+
+    /*!
+     * The exponentially weighted moving average of the round trip time.
+     */
+    std::chrono::microseconds m_average_round_trip_time;
+
+    /*!
+     * Ring of the most recently measured round trip times.
+     */
+    std::vector<std::chrono::microseconds> m_round_trip_samples;
+
+    /*!
+     * The position in the ring at which the next sample is stored.
+     */
+    std::size_t m_round_trip_sample_index;
+
+    /*!
+     * The index of the serializer currently offered to the peer within
+     * the serializers configured in the options.
+     */
+    std::size_t m_serializer_index;
+
+    /*!
+     * The serializer currently offered to the peer.
+     */
+    std::shared_ptr<wamp_serializer> m_serializer;
+
+    /*!
+     * The maximum message length that the peer accepts, as advertised
+     * in its handshake reply, limited to what the 24 bit length prefix
+     * can express.
+     */
+    std::size_t m_max_send_length;
+
     /*!
      * Whether or not debugging is enabled.
      */
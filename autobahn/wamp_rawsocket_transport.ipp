@@ -30,12 +30,16 @@
 
 #include "exceptions.hpp"
 #include "wamp_message.hpp"
+#include "wamp_message_type.hpp"
+#include "wamp_serializers.hpp"
 #include "wamp_transport_handler.hpp"
 
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/placeholders.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
+#include <boost/optional.hpp>
+#include <algorithm>
 #include <system_error>
 
 namespace autobahn {
@@ -44,15 +48,44 @@ template <class Socket>
 wamp_rawsocket_transport<Socket>::wamp_rawsocket_transport(
             boost::asio::io_service& io_service,
             const endpoint_type& remote_endpoint,
-            bool debug_enabled)
+            bool debug_enabled,
+            const wamp_rawsocket_options& options)
     : wamp_transport()
+    , m_io_service(io_service)
     , m_socket(io_service)
     , m_remote_endpoint(remote_endpoint)
     , m_connect()
     , m_disconnect()
     , m_handshake_buffer()
     , m_message_length(0)
-    , m_message_unpacker()
+    , m_message_header_received(false)
+    , m_frame_type(0)
+    , m_receive_buffer_grown(false)
+    , m_message_unpacker(&wamp_rawsocket_transport<Socket>::reference_payload, this,
+            options.receive_buffer_size())
+    , m_write_queue()
+    , m_send_buffers(options.max_pooled_send_buffers(), options.max_pooled_send_buffer_size())
+    , m_write_queue_bytes(0)
+    , m_write_buffers()
+    , m_write_in_progress(false)
+    , m_send_paused(false)
+    , m_receive_paused(false)
+    , m_receive_deferred(false)
+    , m_flush_pending(false)
+    , m_flush_timer(io_service)
+    , m_options(options)
+    , m_ping_timer(io_service)
+    , m_pong_timer(io_service)
+    , m_ping_sequence(0)
+    , m_ping_outstanding(false)
+    , m_ping_sent()
+    , m_round_trip_time(0)
+    , m_average_round_trip_time(0)
+    , m_round_trip_samples()
+    , m_round_trip_sample_index(0)
+    , m_serializer_index(0)
+    , m_serializer(make_wamp_serializer(wamp_rawsocket_serializer::msgpack))
+    , m_max_send_length((1 << 24) - 1)
     , m_debug_enabled(debug_enabled)
 {
     memset(m_handshake_buffer, 0, sizeof(m_handshake_buffer));
@@ -68,6 +101,19 @@ boost::future<void> wamp_rawsocket_transport<Socket>::connect()
         return m_connect.get_future();
     }
 
+    if (!select_serializer(0)) {
+        m_connect.set_exception(boost::copy_exception(protocol_error("no supported rawsocket serializer configured")));
+        return m_connect.get_future();
+    }
+
+    connect_socket();
+
+    return m_connect.get_future();
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::connect_socket()
+{
     std::weak_ptr<wamp_rawsocket_transport<Socket>> weak_self = this->shared_from_this();
     auto connect_handler = [this, weak_self](const boost::system::error_code& error_code) {
         auto shared_self = weak_self.lock();
@@ -82,21 +128,20 @@ boost::future<void> wamp_rawsocket_transport<Socket>::connect()
             return;
         }
 
-        // FIXME: There should be a wamp_rawsocket_properties object or something
-        //        similar that can be passed in to help deal with overiding these
-        //        handshake parameters.
-        //
+        // The maximum length is advertised as an exponent n of 2^(9+n).
+        uint8_t length_exponent = 0;
+        while ((std::size_t(1) << (9 + length_exponent)) < m_options.max_receive_length()) {
+            ++length_exponent;
+        }
+
         // Send the initial handshake packet informing the server which
         // serialization format we wish to use, and our maximum message size.
         m_handshake_buffer[0] = 0x7F; // magic byte
-        m_handshake_buffer[1] = 0xF2; // we are ready to receive messages up to 2**24 octets and encoded using MsgPack
+        m_handshake_buffer[1] = (length_exponent << 4)
+                | static_cast<uint8_t>(m_options.serializers()[m_serializer_index]);
         m_handshake_buffer[2] = 0x00; // reserved
         m_handshake_buffer[3] = 0x00; // reserved
 
-        boost::asio::write(
-                m_socket,
-                boost::asio::buffer(m_handshake_buffer, sizeof(m_handshake_buffer)));
-
         auto handshake_reply = [this, weak_self](
                 const boost::system::error_code& error,
                 std::size_t bytes_transferred) {
@@ -106,20 +151,58 @@ boost::future<void> wamp_rawsocket_transport<Socket>::connect()
             }
         };
 
+        auto handshake_sent = [this, weak_self, handshake_reply](
+                const boost::system::error_code& error,
+                std::size_t /* bytes_transferred */) {
+            auto shared_self = weak_self.lock();
+            if (!shared_self) {
+                return;
+            }
+
+            if (error) {
+                m_connect.set_exception(boost::copy_exception(
+                        std::system_error(error.value(), std::system_category(), "async_write")));
+                return;
+            }
+
+            try {
+                // Read the 4-byte handshake reply from the server
+                boost::asio::async_read(
+                        m_socket,
+                        boost::asio::buffer(m_handshake_buffer, sizeof(m_handshake_buffer)),
+                        handshake_reply);
+            } catch (const std::exception& e) {
+                m_connect.set_exception(boost::copy_exception(e));
+            }
+        };
+
         try {
-            // Read the 4-byte handshake reply from the server
-            boost::asio::async_read(
+            boost::asio::async_write(
                     m_socket,
                     boost::asio::buffer(m_handshake_buffer, sizeof(m_handshake_buffer)),
-                    handshake_reply);
+                    handshake_sent);
         } catch (const std::exception& e) {
             m_connect.set_exception(boost::copy_exception(e));
         }
     };
 
     m_socket.async_connect(m_remote_endpoint, connect_handler);
+}
 
-    return m_connect.get_future();
+template <class Socket>
+bool wamp_rawsocket_transport<Socket>::select_serializer(std::size_t index)
+{
+    const auto& serializers = m_options.serializers();
+    for (; index < serializers.size(); ++index) {
+        auto serializer = make_wamp_serializer(serializers[index]);
+        if (serializer) {
+            m_serializer_index = index;
+            m_serializer = std::move(serializer);
+            return true;
+        }
+    }
+
+    return false;
 }
 
 template <class Socket>
@@ -129,6 +212,9 @@ boost::future<void> wamp_rawsocket_transport<Socket>::disconnect()
         throw network_error("network transport already disconnected");
     }
 
+    m_flush_timer.cancel();
+    m_ping_timer.cancel();
+    m_pong_timer.cancel();
     m_socket.close();
 
     m_disconnect.set_value();
@@ -144,21 +230,69 @@ bool wamp_rawsocket_transport<Socket>::is_connected() const
 template <class Socket>
 void wamp_rawsocket_transport<Socket>::send_message(wamp_message&& message)
 {
-    auto buffer = std::make_shared<msgpack::sbuffer>();
-    msgpack::packer<msgpack::sbuffer> packer(*buffer);
-    packer.pack(message.fields());
-
-    // Write the length prefix as the message header.
-    uint32_t length = htonl((uint32_t) buffer->size());
-    boost::asio::write(m_socket, boost::asio::buffer(&length, sizeof(length)));
+    // Reserve room for the length prefix in front of the message so that
+    // the header and the body go out in a single write.
+    static const char header_placeholder[4] = { 0, 0, 0, 0 };
+    auto buffer = m_send_buffers.acquire();
+    buffer->write(header_placeholder, sizeof(header_placeholder));
+
+    m_serializer->serialize(message, *buffer);
+
+    const std::size_t message_length = buffer->size() - sizeof(header_placeholder);
+    if (message_length > m_max_send_length) {
+        m_send_buffers.release(std::move(buffer));
+        throw protocol_error("message exceeds the maximum length accepted by the peer");
+    }
 
-    // Write actual serialized message.
-    boost::asio::write(m_socket, boost::asio::buffer(buffer->data(), buffer->size()));
+    const uint32_t length = htonl((uint32_t) message_length);
+    memcpy(buffer->data(), &length, sizeof(length));
 
     if (m_debug_enabled) {
-        std::cerr << "TX message (" << buffer->size() << " octets) ..." << std::endl;
+        std::cerr << "TX message (" << message_length << " octets) ..." << std::endl;
         std::cerr << "TX message: " << message << std::endl;
     }
+
+    queue_frame(std::move(buffer));
+
+    // The completion of the write in progress picks up the queued messages.
+    if (m_write_in_progress) {
+        return;
+    }
+
+    // Flush right away once there is enough queued to fill a write,
+    // otherwise give other messages the chance to join this one.
+    if (m_write_queue.size() >= m_options.max_coalesced_messages()
+            || m_write_queue_bytes >= m_options.max_coalesced_bytes()) {
+        send_queued_messages();
+    } else if (!m_flush_pending) {
+        schedule_flush();
+    }
+}
+
+template <class Socket>
+std::chrono::microseconds wamp_rawsocket_transport<Socket>::round_trip_time() const
+{
+    return m_round_trip_time;
+}
+
+template <class Socket>
+std::chrono::microseconds wamp_rawsocket_transport<Socket>::average_round_trip_time() const
+{
+    return m_average_round_trip_time;
+}
+
+template <class Socket>
+std::chrono::microseconds wamp_rawsocket_transport<Socket>::p99_round_trip_time() const
+{
+    if (m_round_trip_samples.empty()) {
+        return std::chrono::microseconds(0);
+    }
+
+    std::vector<std::chrono::microseconds> samples(m_round_trip_samples);
+    const std::size_t index = (samples.size() * 99 - 1) / 100;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+
+    return samples[index];
 }
 
 template <class Socket>
@@ -176,16 +310,25 @@ void wamp_rawsocket_transport<Socket>::set_resume_handler(resume_handler&& handl
 template <class Socket>
 void wamp_rawsocket_transport<Socket>::pause()
 {
-    if (m_pause_handler) {
-        m_pause_handler();
-    }
+    m_receive_paused = true;
+
+    // A PONG cannot be read while receiving is paused, so the peer is not
+    // held responsible for it until receiving resumes.
+    m_pong_timer.cancel();
 }
 
 template <class Socket>
 void wamp_rawsocket_transport<Socket>::resume()
 {
-    if (m_resume_handler) {
-        m_resume_handler();
+    m_receive_paused = false;
+
+    if (m_ping_outstanding) {
+        start_pong_timer();
+    }
+
+    if (m_receive_deferred) {
+        m_receive_deferred = false;
+        receive_message();
     }
 }
 
@@ -225,6 +368,21 @@ Socket& wamp_rawsocket_transport<Socket>::socket()
     return m_socket;
 }
 
+template <class Socket>
+bool wamp_rawsocket_transport<Socket>::reference_payload(
+        msgpack::type::object_type type,
+        std::size_t length,
+        void* user_data)
+{
+    if (type != msgpack::type::STR && type != msgpack::type::BIN) {
+        return false;
+    }
+
+    const auto transport = static_cast<const wamp_rawsocket_transport<Socket>*>(user_data);
+    const std::size_t threshold = transport->m_options.reference_threshold();
+    return threshold != 0 && length >= threshold;
+}
+
 template <class Socket>
 void wamp_rawsocket_transport<Socket>::handshake_reply_handler(
         const boost::system::error_code& error_code,
@@ -256,6 +414,18 @@ void wamp_rawsocket_transport<Socket>::handshake_reply_handler(
             std::cerr << "rawsocket handshake error: " << std::hex << error << std::endl;
         }
 
+        // The peer closes the connection after rejecting a serializer, so
+        // reconnect and offer the next one that we prefer.
+        if (error == 0x10 && select_serializer(m_serializer_index + 1)) {
+            if (m_debug_enabled) {
+                std::cerr << "rawsocket serializer rejected, trying the next one" << std::endl;
+            }
+
+            m_socket.close();
+            connect_socket();
+            return;
+        }
+
         std::stringstream error_string;
         if (error == 0x00) {
             error_string << "illegal error code (" << error << ")";
@@ -276,98 +446,553 @@ void wamp_rawsocket_transport<Socket>::handshake_reply_handler(
     }
 
     uint32_t serializer_type = (m_handshake_buffer[1] & 0x0F);
-    if (serializer_type == 0x01) {
-        m_connect.set_exception(boost::copy_exception(protocol_error("json currently not supported")));
-    } else if (serializer_type == 0x02) {
-        if (m_debug_enabled) {
-            std::cerr << "connect successful: valid handshake" << std::endl;
-        }
-        m_connect.set_value();
-        receive_message();
-    } else {
+    if (serializer_type != static_cast<uint32_t>(m_options.serializers()[m_serializer_index])) {
         std::stringstream error_string;
         error_string << "rawsocket handshake error: invalid serializer type (" << serializer_type << ")";
         m_connect.set_exception(boost::copy_exception(protocol_error(error_string.str())));
+        return;
     }
+
+    // The length prefix has 24 bits, so a peer that accepts 2^24 octets
+    // still cannot be sent more than 2^24 - 1.
+    m_max_send_length = std::min(std::size_t(1) << (9 + (m_handshake_buffer[1] >> 4)),
+            (std::size_t(1) << 24) - 1);
+
+    if (m_debug_enabled) {
+        std::cerr << "connect successful: valid handshake (peer accepts messages up to "
+                << m_max_send_length << " octets)" << std::endl;
+    }
+
+    // Discard anything left over from a previous connection.
+    m_message_header_received = false;
+    m_message_unpacker.reset();
+    m_message_unpacker.remove_nonparsed_buffer();
+    if (m_receive_buffer_grown) {
+        shrink_receive_buffer();
+    }
+
+    m_ping_outstanding = false;
+
+    m_connect.set_value();
+    receive_message();
+    start_ping_timer();
 }
 
 template <class Socket>
-void wamp_rawsocket_transport<Socket>::receive_message()
+void wamp_rawsocket_transport<Socket>::queue_frame(std::shared_ptr<msgpack::sbuffer>&& frame)
+{
+    m_write_queue_bytes += frame->size();
+    m_write_queue.push_back(std::move(frame));
+    check_watermarks();
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::send_control_frame(
+        uint8_t frame_type, const char* payload, std::size_t length)
 {
+    if (length > m_max_send_length) {
+        return;
+    }
+
+    const char header[4] = {
+        static_cast<char>(frame_type),
+        static_cast<char>((length >> 16) & 0xFF),
+        static_cast<char>((length >> 8) & 0xFF),
+        static_cast<char>(length & 0xFF)
+    };
+
+    auto buffer = m_send_buffers.acquire();
+    buffer->write(header, sizeof(header));
+    buffer->write(payload, length);
+
+    queue_frame(std::move(buffer));
+
+    // Control frames are not held back for coalescing.
+    if (!m_write_in_progress) {
+        send_queued_messages();
+    }
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::schedule_flush()
+{
+    m_flush_pending = true;
+
+    if (m_options.max_coalescing_delay().count() > 0) {
+        m_flush_timer.expires_from_now(m_options.max_coalescing_delay());
+        m_flush_timer.async_wait(
+            bind(&wamp_rawsocket_transport<Socket>::flush_handler,
+                this->shared_from_this(),
+                boost::asio::placeholders::error));
+    } else {
+        m_io_service.post(
+            bind(&wamp_rawsocket_transport<Socket>::flush_handler,
+                this->shared_from_this(),
+                boost::system::error_code()));
+    }
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::flush_handler(
+        const boost::system::error_code& error_code)
+{
+    // A cancelled timer or a flush that has already been superseded by
+    // a write that was started in the meantime.
+    if (error_code || !m_flush_pending) {
+        return;
+    }
+
+    if (!m_write_in_progress) {
+        send_queued_messages();
+    }
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::send_queued_messages()
+{
+    if (m_flush_pending) {
+        m_flush_pending = false;
+        m_flush_timer.cancel();
+    }
+
+    if (m_write_queue.empty()) {
+        m_write_in_progress = false;
+        return;
+    }
+
+    m_write_in_progress = true;
+
+    // Gather as many queued messages as the coalescing limits allow into
+    // a single write. The first message is always taken, even if it is
+    // larger than the limit on its own.
+    std::size_t write_bytes = 0;
+    m_write_buffers.clear();
+    for (const auto& buffer : m_write_queue) {
+        if (!m_write_buffers.empty()
+                && (m_write_buffers.size() >= m_options.max_coalesced_messages()
+                    || write_bytes + buffer->size() > m_options.max_coalesced_bytes())) {
+            break;
+        }
+
+        m_write_buffers.push_back(boost::asio::buffer(buffer->data(), buffer->size()));
+        write_bytes += buffer->size();
+    }
+
     if (m_debug_enabled) {
-        std::cerr << "RX preparing to receive message .." << std::endl;
+        std::cerr << "TX writing " << m_write_buffers.size() << " message(s) ("
+                << write_bytes << " octets) ..." << std::endl;
     }
 
-    boost::asio::async_read(
+    boost::asio::async_write(
         m_socket,
-        boost::asio::buffer(&m_message_length, sizeof(m_message_length)),
-        bind(&wamp_rawsocket_transport<Socket>::receive_message_header,
+        m_write_buffers,
+        bind(&wamp_rawsocket_transport<Socket>::send_message_handler,
             this->shared_from_this(),
             boost::asio::placeholders::error,
             boost::asio::placeholders::bytes_transferred));
 }
 
 template <class Socket>
-void wamp_rawsocket_transport<Socket>::receive_message_header(
+void wamp_rawsocket_transport<Socket>::send_message_handler(
         const boost::system::error_code& error_code,
-        std::size_t /* bytes transferred */)
+        std::size_t /* bytes_transferred */)
+{
+    if (error_code) {
+        if (m_debug_enabled && error_code != boost::asio::error::operation_aborted) {
+            std::cerr << "Send error: " << error_code << std::endl;
+        }
+
+        // The connection is unusable, so there is no point in keeping
+        // any of the messages that are still waiting to be written.
+        for (auto& buffer : m_write_queue) {
+            m_send_buffers.release(std::move(buffer));
+        }
+        m_write_queue.clear();
+        m_write_queue_bytes = 0;
+        m_write_buffers.clear();
+        m_write_in_progress = false;
+        check_watermarks();
+
+        // The session has to learn that its messages are not going out.
+        if (error_code != boost::asio::error::operation_aborted && m_socket.is_open()) {
+            fail_connection(error_code.message());
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < m_write_buffers.size(); ++i) {
+        m_write_queue_bytes -= m_write_queue.front()->size();
+        m_send_buffers.release(std::move(m_write_queue.front()));
+        m_write_queue.pop_front();
+    }
+    m_write_buffers.clear();
+    check_watermarks();
+
+    // Everything that was queued while the write was in progress goes
+    // out together in the next write.
+    send_queued_messages();
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::check_watermarks()
 {
-    if (!error_code) {
-        m_message_length = ntohl(m_message_length);
+    if (m_options.high_watermark() == 0) {
+        return;
+    }
 
+    if (!m_send_paused && m_write_queue_bytes >= m_options.high_watermark()) {
         if (m_debug_enabled) {
-            std::cerr << "RX message (" << m_message_length << " octets) ..." << std::endl;
+            std::cerr << "TX queue reached high watermark (" << m_write_queue_bytes
+                    << " octets), pausing" << std::endl;
         }
 
-        m_message_unpacker.reserve_buffer(m_message_length);
+        m_send_paused = true;
+        if (m_pause_handler) {
+            m_pause_handler();
+        }
+    } else if (m_send_paused && m_write_queue_bytes <= m_options.low_watermark()) {
+        if (m_debug_enabled) {
+            std::cerr << "TX queue drained to low watermark (" << m_write_queue_bytes
+                    << " octets), resuming" << std::endl;
+        }
 
-        boost::asio::async_read(
-            m_socket,
-            boost::asio::buffer(m_message_unpacker.buffer(), m_message_length),
-            bind(&wamp_rawsocket_transport<Socket>::receive_message_body,
-                this->shared_from_this(),
-                boost::asio::placeholders::error,
-                boost::asio::placeholders::bytes_transferred));
+        m_send_paused = false;
+        if (m_resume_handler) {
+            m_resume_handler();
+        }
+    }
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::receive_message()
+{
+    // Deliver the frames that are already buffered before reading more.
+    if (!receive_frames()) {
         return;
     }
+
+    // Make sure that the rest of a large frame fits into a single read.
+    // The frame length has been checked against the advertised maximum,
+    // which bounds how far the buffer can grow.
+    std::size_t read_size = m_options.read_size();
+    if (m_message_header_received) {
+        const std::size_t buffered = m_message_unpacker.nonparsed_size();
+        if (m_message_length > buffered && m_message_length - buffered > read_size) {
+            read_size = m_message_length - buffered;
+            m_receive_buffer_grown = true;
+        }
+    } else if (m_receive_buffer_grown) {
+        shrink_receive_buffer();
+    }
+    m_message_unpacker.reserve_buffer(read_size);
+
+    m_socket.async_read_some(
+        boost::asio::buffer(m_message_unpacker.buffer(), m_message_unpacker.buffer_capacity()),
+        bind(&wamp_rawsocket_transport<Socket>::receive_handler,
+            this->shared_from_this(),
+            boost::asio::placeholders::error,
+            boost::asio::placeholders::bytes_transferred));
 }
 
 template <class Socket>
-void wamp_rawsocket_transport<Socket>::receive_message_body(
+void wamp_rawsocket_transport<Socket>::receive_handler(
         const boost::system::error_code& error_code,
-        std::size_t /* bytes transferred */)
+        std::size_t bytes_transferred)
 {
     if (error_code) {
         if (m_debug_enabled && error_code != boost::asio::error::operation_aborted) {
             std::cerr << "Receive error: " << error_code << std::endl;
         }
+
+        // The peer closed the connection or it broke down, nothing that
+        // the session waits for is going to arrive.
+        if (error_code != boost::asio::error::operation_aborted && m_socket.is_open()) {
+            fail_connection(error_code.message());
+        }
         return;
     }
 
     if (m_debug_enabled) {
-        std::cerr << "RX message received." << std::endl;
+        std::cerr << "RX read " << bytes_transferred << " octets" << std::endl;
     }
 
-    if (m_handler) {
-        m_message_unpacker.buffer_consumed(m_message_length);
-        msgpack::unpacked result;
+    m_message_unpacker.buffer_consumed(bytes_transferred);
+    receive_message();
+}
+
+template <class Socket>
+bool wamp_rawsocket_transport<Socket>::receive_frames()
+{
+    for (;;) {
+        // The read is picked up again when receiving is resumed.
+        if (m_receive_paused) {
+            m_receive_deferred = true;
+            return false;
+        }
 
-        while (m_message_unpacker.next(result)) {
-            wamp_message::message_fields fields;
-            result.get().convert(fields);
+        if (!m_message_header_received) {
+            if (m_message_unpacker.nonparsed_size() < sizeof(m_message_length)) {
+                return true;
+            }
+
+            // The first octet carries the frame type in its lower 3 bits,
+            // the remaining 3 octets the length of the frame payload.
+            const uint8_t* header =
+                    reinterpret_cast<const uint8_t*>(m_message_unpacker.nonparsed_buffer());
+            const uint8_t frame_type = header[0];
+            const uint32_t length = (uint32_t(header[1]) << 16)
+                    | (uint32_t(header[2]) << 8)
+                    | uint32_t(header[3]);
+
+            if (frame_type > 0x02) {
+                fail_connection("invalid frame type");
+                return false;
+            }
+
+            if (length > m_options.max_receive_length()) {
+                fail_connection("frame exceeds the advertised maximum length");
+                return false;
+            }
+
+            m_message_unpacker.skip_nonparsed_buffer(sizeof(m_message_length));
+            m_frame_type = frame_type;
+            m_message_length = length;
+            m_message_header_received = true;
 
-            wamp_message message(std::move(fields), std::move(*(result.zone())));
             if (m_debug_enabled) {
-                std::cerr << "RX message: " << message << std::endl;
+                std::cerr << "RX frame (type " << unsigned(m_frame_type) << ", "
+                        << m_message_length << " octets) ..." << std::endl;
+            }
+        }
+
+        const std::size_t buffered = m_message_unpacker.nonparsed_size();
+        if (buffered < m_message_length) {
+            return true;
+        }
+
+        // A PING is answered with a PONG that echoes its payload.
+        if (m_frame_type != 0x00) {
+            const char* payload = m_message_unpacker.nonparsed_buffer();
+            if (m_frame_type == 0x01) {
+                send_control_frame(0x02, payload, m_message_length);
+            } else {
+                receive_pong(payload, m_message_length);
+            }
+
+            m_message_unpacker.skip_nonparsed_buffer(m_message_length);
+            m_message_header_received = false;
+            continue;
+        }
+
+        // A frame has to contain exactly one serialized message. Msgpack
+        // is either copied out to be unpacked lazily or unpacked in place
+        // so that payloads can reference the receive buffer, other formats
+        // are handed to the serializer. Only messages that carry payloads
+        // are decoded lazily, so that their packed arguments can be passed
+        // on as they are. The session unpacks all other messages right away.
+        boost::optional<wamp_message> message;
+        if (m_serializer->rawsocket_id() == wamp_rawsocket_serializer::msgpack
+                && m_options.lazy_decoding()
+                && wamp_message::is_lazily_decoded(
+                        m_message_unpacker.nonparsed_buffer(), m_message_length)) {
+            std::unique_ptr<msgpack::sbuffer> encoded(new msgpack::sbuffer(m_message_length));
+            encoded->write(m_message_unpacker.nonparsed_buffer(), m_message_length);
+            m_message_unpacker.skip_nonparsed_buffer(m_message_length);
+
+            // Locating the fields validates the framing of the message.
+            message = wamp_message(std::move(encoded));
+            try {
+                message->size();
+            } catch (const msgpack::unpack_error&) {
+                fail_connection("invalid message frame");
+                return false;
             }
+        } else if (m_serializer->rawsocket_id() == wamp_rawsocket_serializer::msgpack) {
+            msgpack::unpacked result;
+            if (!m_message_unpacker.next(result)
+                    || buffered - m_message_unpacker.nonparsed_size() != m_message_length) {
+                fail_connection("invalid message frame");
+                return false;
+            }
+            message = wamp_message(result.get(), std::move(*(result.zone())));
+        } else {
+            try {
+                message = m_serializer->deserialize(
+                        m_message_unpacker.nonparsed_buffer(), m_message_length);
+            } catch (const protocol_error& e) {
+                fail_connection(e.what());
+                return false;
+            }
+            m_message_unpacker.skip_nonparsed_buffer(m_message_length);
+        }
+
+        m_message_header_received = false;
 
-            m_handler->on_message(std::move(message));
+        if (!m_handler) {
+            std::cerr << "RX message ignored: no handler attached" << std::endl;
+            continue;
         }
+
+        if (m_debug_enabled) {
+            std::cerr << "RX message: " << *message << std::endl;
+        }
+
+        m_handler->on_message(std::move(*message));
+    }
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::shrink_receive_buffer()
+{
+    // Only shrink once the data left over from the large frame fits
+    // comfortably into a buffer of the steady state size.
+    const std::size_t buffered = m_message_unpacker.nonparsed_size();
+    if (buffered > m_options.receive_buffer_size() / 2) {
+        return;
+    }
+
+    if (m_debug_enabled) {
+        std::cerr << "RX shrinking receive buffer to "
+                << m_options.receive_buffer_size() << " octets" << std::endl;
+    }
+
+    // Buffers that are still referenced by received messages are kept
+    // alive by the zones of those messages.
+    msgpack::unpacker unpacker(&wamp_rawsocket_transport<Socket>::reference_payload, this,
+            m_options.receive_buffer_size());
+    unpacker.reserve_buffer(buffered);
+    memcpy(unpacker.buffer(), m_message_unpacker.nonparsed_buffer(), buffered);
+    unpacker.buffer_consumed(buffered);
+
+    m_message_unpacker = std::move(unpacker);
+    m_receive_buffer_grown = false;
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::fail_connection(const std::string& reason)
+{
+    if (m_debug_enabled) {
+        std::cerr << "RX " << reason << ", closing connection" << std::endl;
+    }
+
+    m_ping_timer.cancel();
+    m_pong_timer.cancel();
+    m_socket.close();
+
+    // Let the session fail what it is waiting for. The handler is detached
+    // first, as the session may well drop the transport while handling it.
+    if (m_handler) {
+        std::shared_ptr<wamp_transport_handler> handler;
+        m_handler.swap(handler);
+        handler->on_detach(false, reason);
+    }
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::receive_pong(const char* payload, std::size_t length)
+{
+    // Only the PONG to the outstanding PING carries a usable measurement.
+    uint64_t sequence = 0;
+    if (!m_ping_outstanding || length != sizeof(sequence)) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < sizeof(sequence); ++i) {
+        sequence = (sequence << 8) | static_cast<uint8_t>(payload[i]);
+    }
+
+    if (sequence != m_ping_sequence) {
+        return;
+    }
+
+    m_ping_outstanding = false;
+    m_pong_timer.cancel();
+
+    m_round_trip_time = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - m_ping_sent);
+
+    // Smooth the same way TCP does with a gain of 1/8.
+    if (m_round_trip_samples.empty()) {
+        m_average_round_trip_time = m_round_trip_time;
     } else {
-        std::cerr << "RX message ignored: no handler attached" << std::endl;
+        m_average_round_trip_time += (m_round_trip_time - m_average_round_trip_time) / 8;
     }
 
-    receive_message();
+    static const std::size_t max_round_trip_samples = 128;
+    if (m_round_trip_samples.size() < max_round_trip_samples) {
+        m_round_trip_samples.push_back(m_round_trip_time);
+    } else {
+        m_round_trip_samples[m_round_trip_sample_index] = m_round_trip_time;
+    }
+    m_round_trip_sample_index = (m_round_trip_sample_index + 1) % max_round_trip_samples;
+
+    if (m_debug_enabled) {
+        std::cerr << "RX PONG (round trip time " << m_round_trip_time.count() << "us)" << std::endl;
+    }
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::start_ping_timer()
+{
+    if (m_options.ping_interval().count() <= 0) {
+        return;
+    }
+
+    m_ping_timer.expires_from_now(m_options.ping_interval());
+    m_ping_timer.async_wait(
+        bind(&wamp_rawsocket_transport<Socket>::ping_handler,
+            this->shared_from_this(),
+            boost::asio::placeholders::error));
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::ping_handler(
+        const boost::system::error_code& error_code)
+{
+    if (error_code || !m_socket.is_open()) {
+        return;
+    }
+
+    // Wait for the PONG to the previous PING rather than piling up PINGs,
+    // the pong timer takes care of peers that stopped answering. No PING
+    // is sent while receiving is paused, as its PONG could not be read.
+    if (!m_ping_outstanding && !m_receive_paused) {
+        ++m_ping_sequence;
+
+        char payload[sizeof(m_ping_sequence)];
+        for (std::size_t i = 0; i < sizeof(payload); ++i) {
+            payload[i] = static_cast<char>((m_ping_sequence >> (8 * (sizeof(payload) - 1 - i))) & 0xFF);
+        }
+
+        m_ping_outstanding = true;
+        m_ping_sent = std::chrono::steady_clock::now();
+        send_control_frame(0x01, payload, sizeof(payload));
+        start_pong_timer();
+    }
+
+    start_ping_timer();
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::start_pong_timer()
+{
+    m_pong_timer.expires_from_now(m_options.ping_timeout());
+    m_pong_timer.async_wait(
+        bind(&wamp_rawsocket_transport<Socket>::pong_timeout_handler,
+            this->shared_from_this(),
+            boost::asio::placeholders::error));
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::pong_timeout_handler(
+        const boost::system::error_code& error_code)
+{
+    // The timer may have expired just before receiving was paused.
+    if (error_code || !m_ping_outstanding || m_receive_paused) {
+        return;
+    }
+
+    fail_connection("PONG timeout");
 }
 
 } // namespace autobahn
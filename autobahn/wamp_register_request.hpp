@@ -35,24 +35,41 @@
 #include "wamp_registration.hpp"
 #include "boost_config.hpp"
 
+#include <boost/exception_ptr.hpp>
+
 namespace autobahn {
 
-/// An outstanding wamp call.
+/// An outstanding wamp register request.
 class wamp_register_request
 {
 public:
-    wamp_register_request();
-    wamp_register_request(const wamp_procedure& procedure);
-    wamp_register_request(wamp_register_request&& other);
+    explicit wamp_register_request(const wamp_procedure& procedure);
+    virtual ~wamp_register_request();
 
     const wamp_procedure& procedure() const;
-    boost::promise<wamp_registration>& response();
-    void set_procedure(wamp_procedure procedure) const;
-    void set_response(const wamp_registration& registration);
+
+    virtual void set_response(const wamp_registration& registration) = 0;
+    virtual void set_exception(const boost::exception_ptr& exception) = 0;
 
 private:
     wamp_procedure m_procedure;
-    boost::promise<wamp_registration> m_response;
+};
+
+/// An outstanding wamp register request that reports its response through a
+/// completion, either a wamp_promise_completion or a wamp_handler_completion.
+template <typename Completion>
+class wamp_basic_register_request : public wamp_register_request
+{
+public:
+    wamp_basic_register_request(const wamp_procedure& procedure, Completion&& completion);
+
+    Completion& completion();
+
+    virtual void set_response(const wamp_registration& registration) override;
+    virtual void set_exception(const boost::exception_ptr& exception) override;
+
+private:
+    Completion m_completion;
 };
 
 } // namespace autobahn
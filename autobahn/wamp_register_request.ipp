@@ -30,21 +30,12 @@
 
 namespace autobahn {
 
-inline wamp_register_request::wamp_register_request()
-    : m_procedure()
-    , m_response()
-{
-}
-
 inline wamp_register_request::wamp_register_request(const wamp_procedure& procedure)
     : m_procedure(procedure)
-    , m_response()
 {
 }
 
-inline wamp_register_request::wamp_register_request(wamp_register_request&& other)
-    : m_procedure(std::move(other.m_procedure))
-    , m_response(std::move(other.m_response))
+inline wamp_register_request::~wamp_register_request()
 {
 }
 
@@ -53,14 +44,30 @@ inline const wamp_procedure& wamp_register_request::procedure() const
     return m_procedure;
 }
 
-inline boost::promise<wamp_registration>& wamp_register_request::response()
+template <typename Completion>
+inline wamp_basic_register_request<Completion>::wamp_basic_register_request(
+        const wamp_procedure& procedure, Completion&& completion)
+    : wamp_register_request(procedure)
+    , m_completion(std::move(completion))
+{
+}
+
+template <typename Completion>
+inline Completion& wamp_basic_register_request<Completion>::completion()
+{
+    return m_completion;
+}
+
+template <typename Completion>
+inline void wamp_basic_register_request<Completion>::set_response(const wamp_registration& registration)
 {
-    return m_response;
+    m_completion.set_value(wamp_registration(registration));
 }
 
-inline void wamp_register_request::set_response(const wamp_registration& registration)
+template <typename Completion>
+inline void wamp_basic_register_request<Completion>::set_exception(const boost::exception_ptr& exception)
 {
-    m_response.set_value(registration);
+    m_completion.set_exception(exception);
 }
 
 } // namespace autobahn
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_SERIALIZER_HPP
+#define AUTOBAHN_WAMP_SERIALIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <msgpack/sbuffer.hpp>
+
+namespace autobahn {
+
+class wamp_message;
+
+/*!
+ * The serializer identifiers used in the rawsocket handshake.
+ */
+enum class wamp_rawsocket_serializer : uint8_t
+{
+    json = 0x01,
+    msgpack = 0x02,
+    cbor = 0x03
+};
+
+/*!
+ * Provides the interface for the serialization formats that wamp
+ * messages can be exchanged in. Messages are always represented by
+ * msgpack objects in memory, a serializer translates between those
+ * objects and its wire format.
+ */
+class wamp_serializer
+{
+public:
+    virtual ~wamp_serializer() = default;
+
+    /*!
+     * The name of the serialization format.
+     */
+    virtual const char* name() const = 0;
+
+    /*!
+     * The websocket subprotocol that selects the serialization format.
+     */
+    virtual const char* subprotocol() const = 0;
+
+    /*!
+     * The identifier that selects the serialization format in the
+     * rawsocket handshake.
+     */
+    virtual wamp_rawsocket_serializer rawsocket_id() const = 0;
+
+    /*!
+     * Whether the serialization format is binary or text. This decides
+     * the type of websocket frames that messages are sent in.
+     */
+    virtual bool is_binary() const = 0;
+
+    /*!
+     * Serializes a message by appending it to the given buffer.
+     *
+     * @param message The message to serialize.
+     * @param buffer The buffer to append the serialized message to.
+     */
+    virtual void serialize(const wamp_message& message, msgpack::sbuffer& buffer) const = 0;
+
+    /*!
+     * Deserializes a message. Throws a protocol_error if the data does not
+     * hold exactly one valid message.
+     *
+     * @param data The serialized message.
+     * @param length The length of the serialized message.
+     *
+     * @return The deserialized message.
+     */
+    virtual wamp_message deserialize(const char* data, std::size_t length) const = 0;
+};
+
+} // namespace autobahn
+
+#endif // AUTOBAHN_WAMP_SERIALIZER_HPP
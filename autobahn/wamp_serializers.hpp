@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_SERIALIZERS_HPP
+#define AUTOBAHN_WAMP_SERIALIZERS_HPP
+
+#include "wamp_cbor_serializer.hpp"
+#include "wamp_json_serializer.hpp"
+#include "wamp_msgpack_serializer.hpp"
+#include "wamp_serializer.hpp"
+
+#include <memory>
+
+namespace autobahn {
+
+/*!
+ * Creates the serializer for a rawsocket serializer identifier.
+ *
+ * @param id The rawsocket serializer identifier.
+ *
+ * @return The serializer, or null if the serialization format is not supported.
+ */
+std::shared_ptr<wamp_serializer> make_wamp_serializer(wamp_rawsocket_serializer id);
+
+} // namespace autobahn
+
+#include "wamp_serializers.ipp"
+
+#endif // AUTOBAHN_WAMP_SERIALIZERS_HPP
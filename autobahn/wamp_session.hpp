@@ -33,15 +33,23 @@
 
 #include "wamp_call_options.hpp"
 #include "wamp_call_result.hpp"
+#include "wamp_completion.hpp"
 #include "wamp_event_handler.hpp"
+#include "wamp_id_map.hpp"
 #include "wamp_message.hpp"
 #include "wamp_procedure.hpp"
 #include "wamp_publish_options.hpp"
+#include "wamp_raw_payload.hpp"
+#include "wamp_slab.hpp"
 #include "wamp_subscribe_options.hpp"
+#include "wamp_timer_wheel.hpp"
 #include "wamp_transport_handler.hpp"
+#include "wamp_uri.hpp"
+#include "wamp_zone_pool.hpp"
 #include "boost_config.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/asio/steady_timer.hpp>
 
 #include <msgpack/object.hpp>
 
@@ -67,6 +75,7 @@
 namespace autobahn {
 
 class wamp_call;
+class wamp_join_request;
 class wamp_message;
 class wamp_register_request;
 class wamp_registration;
@@ -126,6 +135,8 @@ public:
      * \param authmethods The authentication methods this instance support e.g. "wampcra","ticket"
      * \param authid The username or maybe an other identifier for the user to join.
      * \return A future that resolves with the session ID when the realm was joined.
+     *         It throws an abort_error with the reason URI if the router
+     *         aborts the join.
      */
     boost::future<uint64_t> join(
             const std::string& realm,
@@ -133,6 +144,39 @@ public:
             const std::string& authid = "",
             const std::map<std::string, std::string>& authentication_extra = {});
 
+    /*!
+     * Join a realm with the session and report the session ID to an Asio
+     * completion token, for example with
+     * `uint64_t id = co_await session->async_join("realm1", boost::asio::use_awaitable);`
+     *
+     * \param realm The realm to join on the application router.
+     * \param token The completion token, with the signature
+     *        void(boost::system::error_code, uint64_t).
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, uint64_t))
+    async_join(const std::string& realm, CompletionToken&& token);
+
+    /*!
+     * Join a realm with the session, authenticating with one of the given
+     * methods, and report the session ID to an Asio completion token.
+     *
+     * \param realm The realm to join on the application router.
+     * \param authmethods The authentication methods this instance support e.g. "wampcra","ticket"
+     * \param authid The username or maybe an other identifier for the user to join.
+     * \param authentication_extra Extra information passed along with the authentication.
+     * \param token The completion token, with the signature
+     *        void(boost::system::error_code, uint64_t).
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, uint64_t))
+    async_join(
+            const std::string& realm,
+            const std::vector<std::string>& authmethods,
+            const std::string& authid,
+            const std::map<std::string, std::string>& authentication_extra,
+            CompletionToken&& token);
+
     /*!
      * Leave the realm.
      *
@@ -181,6 +225,70 @@ public:
             const Map& kw_arguments,
             const wamp_publish_options& options = wamp_publish_options());
 
+    /*!
+     * \ingroup PUB
+     * Publish an event with empty payload to a topic given as a packed URI.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \return A future that resolves once the the topic has been published to.
+     */
+    boost::future<void> publish(const wamp_uri& topic,
+                                const wamp_publish_options& options = wamp_publish_options());
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with positional payload to a topic given as a packed URI.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     * \return A future that resolves once the the topic has been published to.
+     */
+    template <typename List>
+    boost::future<void> publish(const wamp_uri& topic, const List& arguments,
+                                const wamp_publish_options& options = wamp_publish_options());
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with both positional and keyword payload to a topic
+     * given as a packed URI.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     * \param kw_arguments The keyword payload for the event.
+     * \return A future that resolves once the the topic has been published to.
+     */
+    template <typename List, typename Map>
+    boost::future<void> publish(
+            const wamp_uri& topic,
+            const List& arguments,
+            const Map& kw_arguments,
+            const wamp_publish_options& options = wamp_publish_options());
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with an already packed payload to a topic, such as
+     * the raw payload of an event that is being forwarded. The payload is
+     * copied before the call returns.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param payload The packed payload for the event.
+     * \return A future that resolves once the the topic has been published to.
+     */
+    boost::future<void> publish(const std::string& topic, const wamp_raw_payload& payload,
+                                const wamp_publish_options& options = wamp_publish_options());
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with an already packed payload to a topic given as a
+     * packed URI. The payload is copied before the call returns.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param payload The packed payload for the event.
+     * \return A future that resolves once the the topic has been published to.
+     */
+    boost::future<void> publish(const wamp_uri& topic, const wamp_raw_payload& payload,
+                                const wamp_publish_options& options = wamp_publish_options());
+
     /*!
      * Subscribe a handler to a topic to receive events.
      *
@@ -194,6 +302,19 @@ public:
             const wamp_event_handler& handler,
             const wamp_subscribe_options& options = wamp_subscribe_options());
 
+    /*!
+     * Subscribe a handler to a topic given as a packed URI.
+     *
+     * \param topic The URI of the topic to subscribe to.
+     * \param handler The handler that will receive events under the subscription.
+     * \param options The options to pass in the subscribe request to the router.
+     * \return A future that resolves to the autobahn::subscription.
+     */
+    boost::future<wamp_subscription> subscribe(
+            const wamp_uri& topic,
+            const wamp_event_handler& handler,
+            const wamp_subscribe_options& options = wamp_subscribe_options());
+
     /*!
      * Unubscribe a handler to previously subscribed topic.
      *
@@ -242,6 +363,76 @@ public:
             const List& arguments, const Map& kw_arguments,
             const wamp_call_options& options = wamp_call_options());
 
+    /*!
+     * Calls a remote procedure given as a packed URI with no arguments.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param options The options to pass in the call to the router.
+     * \return A future that resolves to the result of the remote procedure call.
+     */
+    boost::future<wamp_call_result> call(
+            const wamp_uri& procedure,
+            const wamp_call_options& options = wamp_call_options());
+
+    /*!
+     * Calls a remote procedure given as a packed URI with positional arguments.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call.
+     * \param options The options to pass in the call to the router.
+     * \return A future that resolves to the result of the remote procedure call.
+     */
+    template <typename List>
+    boost::future<wamp_call_result> call(
+            const wamp_uri& procedure,
+            const List& arguments,
+            const wamp_call_options& options = wamp_call_options());
+
+    /*!
+     * Calls a remote procedure given as a packed URI with positional and
+     * keyword arguments.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call.
+     * \param kw_arguments The keyword arguments for the call.
+     * \param options The options to pass in the call to the router.
+     * \return A future that resolves to the result of the remote procedure call.
+     */
+    template<typename List, typename Map>
+    boost::future<wamp_call_result> call(
+            const wamp_uri& procedure,
+            const List& arguments, const Map& kw_arguments,
+            const wamp_call_options& options = wamp_call_options());
+
+    /*!
+     * Calls a remote procedure with already packed arguments, such as the
+     * raw payload of an invocation that is being forwarded. The payload is
+     * copied before the call returns.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param payload The packed arguments for the call.
+     * \param options The options to pass in the call to the router.
+     * \return A future that resolves to the result of the remote procedure call.
+     */
+    boost::future<wamp_call_result> call(
+            const std::string& procedure,
+            const wamp_raw_payload& payload,
+            const wamp_call_options& options = wamp_call_options());
+
+    /*!
+     * Calls a remote procedure given as a packed URI with already packed
+     * arguments. The payload is copied before the call returns.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param payload The packed arguments for the call.
+     * \param options The options to pass in the call to the router.
+     * \return A future that resolves to the result of the remote procedure call.
+     */
+    boost::future<wamp_call_result> call(
+            const wamp_uri& procedure,
+            const wamp_raw_payload& payload,
+            const wamp_call_options& options = wamp_call_options());
+
     /*!
      * Register a procedure that can be called remotely.
      *
@@ -263,6 +454,190 @@ public:
     */
     boost::future<void> unprovide(const wamp_registration& registration);
 
+    /*!
+     * \ingroup PUB
+     * Publish an event with empty payload to a topic and report to an Asio
+     * completion token once it has been sent.
+     *
+     * The async_ operations take any Asio completion token: a plain callback,
+     * boost::asio::use_future, a boost::asio::yield_context or, with C++20,
+     * boost::asio::use_awaitable. They complete through the token's associated
+     * executor, or else through the session's io service, with an error code
+     * from wamp_category() where the future based operations would throw.
+     * A callback does not allocate any future or promise state.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param options The options to pass in the publish request to the router.
+     * \param token The completion token, with the signature void(boost::system::error_code).
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+    async_publish(const std::string& topic, const wamp_publish_options& options, CompletionToken&& token);
+
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+    async_publish(const wamp_uri& topic, const wamp_publish_options& options, CompletionToken&& token);
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with positional payload to a topic and report to an
+     * Asio completion token once it has been sent.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event, or a wamp_raw_payload.
+     * \param options The options to pass in the publish request to the router.
+     * \param token The completion token, with the signature void(boost::system::error_code).
+     */
+    template <typename List, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+    async_publish(const std::string& topic, const List& arguments,
+            const wamp_publish_options& options, CompletionToken&& token);
+
+    template <typename List, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+    async_publish(const wamp_uri& topic, const List& arguments,
+            const wamp_publish_options& options, CompletionToken&& token);
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with both positional and keyword payload to a topic
+     * and report to an Asio completion token once it has been sent.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     * \param kw_arguments The keyword payload for the event.
+     * \param options The options to pass in the publish request to the router.
+     * \param token The completion token, with the signature void(boost::system::error_code).
+     */
+    template <typename List, typename Map, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+    async_publish(const std::string& topic, const List& arguments, const Map& kw_arguments,
+            const wamp_publish_options& options, CompletionToken&& token);
+
+    template <typename List, typename Map, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+    async_publish(const wamp_uri& topic, const List& arguments, const Map& kw_arguments,
+            const wamp_publish_options& options, CompletionToken&& token);
+
+    /*!
+     * Subscribe a handler to a topic and report the subscription to an Asio
+     * completion token.
+     *
+     * \param topic The URI of the topic to subscribe to.
+     * \param handler The handler that will receive events under the subscription.
+     * \param options The options to pass in the subscribe request to the router.
+     * \param token The completion token, with the signature
+     *        void(boost::system::error_code, wamp_subscription).
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_subscription))
+    async_subscribe(const std::string& topic, const wamp_event_handler& handler,
+            const wamp_subscribe_options& options, CompletionToken&& token);
+
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_subscription))
+    async_subscribe(const wamp_uri& topic, const wamp_event_handler& handler,
+            const wamp_subscribe_options& options, CompletionToken&& token);
+
+    /*!
+     * Calls a remote procedure with no arguments and reports the result to
+     * an Asio completion token.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param options The options to pass in the call to the router.
+     * \param token The completion token, with the signature
+     *        void(boost::system::error_code, wamp_call_result). On an ERROR
+     *        the call result carries its error URI and arguments.
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+    async_call(const std::string& procedure, const wamp_call_options& options, CompletionToken&& token);
+
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+    async_call(const wamp_uri& procedure, const wamp_call_options& options, CompletionToken&& token);
+
+    /*!
+     * Calls a remote procedure with positional arguments and reports the
+     * result to an Asio completion token.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call, or a wamp_raw_payload.
+     * \param options The options to pass in the call to the router.
+     * \param token The completion token, with the signature
+     *        void(boost::system::error_code, wamp_call_result). On an ERROR
+     *        the call result carries its error URI and arguments.
+     */
+    template <typename List, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+    async_call(const std::string& procedure, const List& arguments,
+            const wamp_call_options& options, CompletionToken&& token);
+
+    template <typename List, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+    async_call(const wamp_uri& procedure, const List& arguments,
+            const wamp_call_options& options, CompletionToken&& token);
+
+    /*!
+     * Calls a remote procedure with positional and keyword arguments and
+     * reports the result to an Asio completion token.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call.
+     * \param kw_arguments The keyword arguments for the call.
+     * \param options The options to pass in the call to the router.
+     * \param token The completion token, with the signature
+     *        void(boost::system::error_code, wamp_call_result). On an ERROR
+     *        the call result carries its error URI and arguments.
+     */
+    template <typename List, typename Map, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+    async_call(const std::string& procedure, const List& arguments, const Map& kw_arguments,
+            const wamp_call_options& options, CompletionToken&& token);
+
+    template <typename List, typename Map, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+    async_call(const wamp_uri& procedure, const List& arguments, const Map& kw_arguments,
+            const wamp_call_options& options, CompletionToken&& token);
+
+    /*!
+     * Register a procedure that can be called remotely and report the
+     * registration to an Asio completion token.
+     *
+     * \param uri The URI associated with the procedure.
+     * \param procedure The procedure to be exposed as a remotely callable procedure.
+     * \param options Options for registering the procedure.
+     * \param token The completion token, with the signature
+     *        void(boost::system::error_code, wamp_registration).
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_registration))
+    async_provide(const std::string& uri, const wamp_procedure& procedure,
+            const provide_options& options, CompletionToken&& token);
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+    /*!
+     * Register a coroutine that can be called remotely and report the
+     * registration to an Asio completion token. Each invocation runs as a
+     * new coroutine on the session's io service, which replies through the
+     * invocation as a plain procedure would. Calls made from the coroutine
+     * with boost::asio::use_awaitable resume it on the io service as well.
+     *
+     * If the coroutine exits with an exception before it has replied, the
+     * invocation fails with wamp.error.runtime_error.
+     *
+     * \param uri The URI associated with the procedure.
+     * \param procedure The coroutine to be exposed as a remotely callable procedure.
+     * \param options Options for registering the procedure.
+     * \param token The completion token, with the signature
+     *        void(boost::system::error_code, wamp_registration).
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_registration))
+    async_provide_coroutine(const std::string& uri, const wamp_coroutine_procedure& procedure,
+            const provide_options& options, CompletionToken&& token);
+#endif
+
     /*!
      * Function called by the session when authenticating. It always has to be
      * re-implemented (if authentication is part of the system).
@@ -308,6 +683,79 @@ public:
     const std::unordered_map<std::string, msgpack::object>& welcome_details();
 
 private:
+    // Build and send the PUBLISH, SUBSCRIBE and CALL messages. The topic
+    // or procedure is either a std::string or a wamp_uri.
+    template <typename Topic, typename... Arguments>
+    boost::future<void> publish_event(
+            const Topic& topic, const wamp_publish_options& options, const Arguments&... arguments);
+
+    template <typename Topic>
+    boost::future<wamp_subscription> subscribe_topic(
+            const Topic& topic,
+            const wamp_event_handler& handler,
+            const wamp_subscribe_options& options);
+
+    template <typename Procedure, typename... Arguments>
+    boost::future<wamp_call_result> call_procedure(
+            const Procedure& procedure, const wamp_call_options& options, const Arguments&... arguments);
+
+    // The same for the async_ operations, which take the completion token
+    // first so that the arguments can be deduced.
+    template <typename CompletionToken, typename Topic, typename... Arguments>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+    async_publish_event(CompletionToken&& token,
+            const Topic& topic, const wamp_publish_options& options, const Arguments&... arguments);
+
+    template <typename CompletionToken, typename Topic>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_subscription))
+    async_subscribe_topic(CompletionToken&& token,
+            const Topic& topic, const wamp_event_handler& handler, const wamp_subscribe_options& options);
+
+    template <typename CompletionToken, typename Procedure, typename... Arguments>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+    async_call_procedure(CompletionToken&& token,
+            const Procedure& procedure, const wamp_call_options& options, const Arguments&... arguments);
+
+    // Initiate the async_ operations once the completion token has been
+    // turned into a handler.
+    struct publish_initiation;
+    struct subscribe_initiation;
+    struct call_initiation;
+    struct register_initiation;
+    struct join_initiation;
+
+    // Sends a PUBLISH message on the io service and completes the request.
+    template <typename Completion>
+    class publish_operation;
+
+    // Builds the HELLO message for joining a realm.
+    std::shared_ptr<wamp_message> make_hello_message(
+            const std::string& realm,
+            const std::vector<std::string>& authentication_methods,
+            const std::string& authentication_id,
+            const std::map<std::string, std::string>& authentication_extra);
+
+    // Send the request and track it until the response arrives.
+    void start_join(
+            const std::shared_ptr<wamp_message>& message,
+            const std::shared_ptr<wamp_join_request>& join_request);
+    void start_call(uint64_t request_id, const std::shared_ptr<wamp_call>& call);
+
+    // Fail a call that ran out of time and ask the router to cancel it.
+    // The call is kept until the router confirms the cancellation or the
+    // timeout passes once more, so that a late reply is not mistaken for a
+    // protocol violation.
+    void process_call_timeout(uint64_t request_id);
+    void arm_call_timeout_timer();
+    void start_subscribe(
+            uint64_t request_id,
+            const std::shared_ptr<wamp_message>& message,
+            const std::shared_ptr<wamp_subscribe_request>& subscribe_request);
+    void start_register(
+            uint64_t request_id,
+            const std::shared_ptr<wamp_message>& message,
+            const std::shared_ptr<wamp_register_request>& register_request);
+
     // Implements the wamp transport handler interface.
     virtual void on_attach(const std::shared_ptr<wamp_transport>& transport) override;
     virtual void on_detach(bool was_clean, const std::string& reason) override;
@@ -346,14 +794,20 @@ private:
     // Last request ID of outgoing WAMP requests.
     std::atomic<uint64_t> m_request_id;
 
+    // Zones reused by the outgoing messages built by this session.
+    std::shared_ptr<wamp_zone_pool> m_zone_pool;
+
+    // Memory reused by the records of pending calls.
+    std::shared_ptr<wamp_slab> m_call_slab;
+
     // WAMP session ID (if the session is joined to a realm).
     uint64_t m_session_id;
 
     // Synchronization for dealing with starting the session.
     boost::promise<void> m_session_start;
 
-    // Future to be fired when session was joined.
-    boost::promise<uint64_t> m_session_join;
+    // The outstanding request to join a realm, if any.
+    std::shared_ptr<wamp_join_request> m_join_request;
 
     // Whether or not we have already sent a goodbye when leaving the session.
     bool m_goodbye_sent;
@@ -369,32 +823,41 @@ private:
     //////////////////////////////////////////////////////////////////////////////////////
     // Caller
 
+    // Deadlines of the pending calls that have a timeout. Declared before
+    // the calls, whose deadlines remove themselves when they are destroyed.
+    wamp_timer_wheel m_call_timeouts;
+
+    // Timer used for advancing the call deadlines while there are any.
+    boost::asio::steady_timer m_call_timeout_timer;
+    bool m_call_timeout_timer_armed;
+
     // Track pending calls by request id.
-    std::map<uint64_t /*request id*/, std::shared_ptr<wamp_call>> m_calls;
+    wamp_id_map<std::shared_ptr<wamp_call>> m_calls;
 
     //////////////////////////////////////////////////////////////////////////////////////
     // Subscriber
 
     // Pending subscribe requests by request id.
-    std::map<uint64_t /*request id*/, std::shared_ptr<wamp_subscribe_request>> m_subscribe_requests;
+    wamp_id_map<std::shared_ptr<wamp_subscribe_request>> m_subscribe_requests;
 
     // Pending unsubscribe requests by request id.
-    std::map<uint64_t /*request id*/, std::shared_ptr<wamp_unsubscribe_request>> m_unsubscribe_requests;
+    wamp_id_map<std::shared_ptr<wamp_unsubscribe_request>> m_unsubscribe_requests;
 
-    // Event handlers by subscription id.
-    std::multimap<uint64_t /*subscription id*/, wamp_event_handler> m_subscription_handlers;
+    // Event handlers by subscription id. Subscribing to a topic more than
+    // once adds another handler to its subscription.
+    wamp_id_map<std::vector<wamp_event_handler>> m_subscription_handlers;
 
     //////////////////////////////////////////////////////////////////////////////////////
     // Callee
 
     // Map of outstanding WAMP register requests (request ID -> register request).
-    std::map<uint64_t, std::shared_ptr<wamp_register_request>> m_register_requests;
+    wamp_id_map<std::shared_ptr<wamp_register_request>> m_register_requests;
 
     // Map of outstanding WAMP unregister requests (request ID -> unregister request).
-    std::map<uint64_t, std::shared_ptr<wamp_unregister_request>> m_unregister_requests;
+    wamp_id_map<std::shared_ptr<wamp_unregister_request>> m_unregister_requests;
 
     // Map of registered procedures (registration ID -> procedure)
-    std::map<uint64_t, wamp_procedure> m_procedures;
+    wamp_id_map<wamp_procedure> m_procedures;
 
     // Welcome details
     std::unordered_map<std::string, msgpack::object> m_welcome_details;
@@ -32,7 +32,9 @@
 #include "wamp_call.hpp"
 #include "wamp_event.hpp"
 #include "wamp_invocation.hpp"
+#include "wamp_join_request.hpp"
 #include "wamp_message.hpp"
+#include "wamp_message_encoder.hpp"
 #include "wamp_message_type.hpp"
 #include "wamp_publication.hpp"
 #include "wamp_registration.hpp"
@@ -53,6 +55,9 @@
 #endif
 
 #include <boost/system/error_code.hpp>
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+#include <boost/asio/co_spawn.hpp>
+#endif
 #include <cstdint>
 #include <exception>
 #include <iostream>
@@ -68,9 +73,14 @@ inline wamp_session::wamp_session(
     , m_io_service(io_service)
     , m_transport()
     , m_request_id(0)
+    , m_zone_pool(std::make_shared<wamp_zone_pool>())
+    , m_call_slab(std::make_shared<wamp_slab>())
     , m_session_id(0)
     , m_goodbye_sent(false)
     , m_running(false)
+    , m_call_timeouts()
+    , m_call_timeout_timer(io_service)
+    , m_call_timeout_timer_armed(false)
 {
 }
 
@@ -143,71 +153,20 @@ inline boost::future<uint64_t> wamp_session::join(
         const std::string& authentication_id,
         const std::map<std::string, std::string>& authentication_extra)
 {
-    msgpack::zone zone;
-    std::unordered_map<std::string, msgpack::object> roles;
+    auto message = make_hello_message(realm, authentication_methods, authentication_id, authentication_extra);
 
-    std::unordered_map<std::string, bool> caller_features;
-    caller_features["call_timeout"] = true;
-    std::unordered_map<std::string, msgpack::object> caller;
-    caller["features"] = msgpack::object(caller_features, zone);
-    roles["caller"] = msgpack::object(caller, zone);
-
-    std::unordered_map<std::string, bool> callee_features;
-    callee_features["call_timeout"] = true;
-    std::unordered_map<std::string, msgpack::object> callee;
-    callee["features"] = msgpack::object(callee_features, zone);
-    roles["callee"] = msgpack::object(callee, zone);
-
-    std::unordered_map<std::string, msgpack::object> publisher;
-    roles["publisher"] = msgpack::object(publisher, zone);
-
-    std::unordered_map<std::string, msgpack::object> subscriber;
-    roles["subscriber"] = msgpack::object(subscriber, zone);
-
-    std::unordered_map<std::string, msgpack::object> details;
-    details["roles"] = msgpack::object(roles, zone);
-    details["authmethods"] = msgpack::object(authentication_methods, zone);
-    details["authid"] = msgpack::object(authentication_id, zone);
+    using completion_type = wamp_promise_completion<uint64_t>;
+    auto join_request = std::make_shared<wamp_basic_join_request<completion_type>>(completion_type());
+    auto response = join_request->completion().get_future();
 
-    if (!authentication_extra.empty()) {
-      std::unordered_map<std::string, msgpack::object> authextra;
-      for (auto const &a : authentication_extra) {
-        authextra[a.first] = msgpack::object(a.second, zone);
-      }
-      details["authextra"] = msgpack::object(authextra, zone);
-    }
-
-    auto message = std::make_shared<wamp_message>(3, std::move(zone));
-    message->set_field(0, static_cast<int>(message_type::HELLO));
-    message->set_field(1, realm);
-    message->set_field(2, details);
-
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-
-    m_io_service.dispatch([this, weak_self, message]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
-
-        if (m_session_id) {
-            m_session_join.set_exception(boost::copy_exception(protocol_error("session already joined")));
-            return;
-        }
+    start_join(message, join_request);
 
-        try {
-            send_message(std::move(*message), false);
-        } catch (const std::exception& e) {
-            m_session_join.set_exception(boost::copy_exception(e));
-        }
-    });
-
-    return m_session_join.get_future();
+    return response;
 }
 
 inline boost::future<std::string> wamp_session::leave(const std::string& reason)
 {
-    auto message = std::make_shared<wamp_message>(3);
+    auto message = std::make_shared<wamp_message>(3, m_zone_pool);
     message->set_field(0, static_cast<int>(message_type::GOODBYE));
     message->set_field(1, std::unordered_map<int, int>() /* No Details */);
     message->set_field(2, reason);
@@ -238,19 +197,83 @@ inline boost::future<std::string> wamp_session::leave(const std::string& reason)
 }
 
 inline boost::future<void> wamp_session::publish(const std::string& topic,const wamp_publish_options& options)
+{
+    return publish_event(topic, options);
+}
+
+template <typename List>
+inline boost::future<void> wamp_session::publish(const std::string& topic, const List& arguments,const wamp_publish_options& options)
+{
+    return publish_event(topic, options, arguments);
+}
+
+template <typename List, typename Map>
+inline boost::future<void> wamp_session::publish(
+        const std::string& topic, const List& arguments, const Map& kw_arguments,const wamp_publish_options& options)
+{
+    return publish_event(topic, options, arguments, kw_arguments);
+}
+
+inline boost::future<void> wamp_session::publish(const wamp_uri& topic, const wamp_publish_options& options)
+{
+    return publish_event(topic, options);
+}
+
+template <typename List>
+inline boost::future<void> wamp_session::publish(
+        const wamp_uri& topic, const List& arguments, const wamp_publish_options& options)
+{
+    return publish_event(topic, options, arguments);
+}
+
+template <typename List, typename Map>
+inline boost::future<void> wamp_session::publish(
+        const wamp_uri& topic, const List& arguments, const Map& kw_arguments, const wamp_publish_options& options)
+{
+    return publish_event(topic, options, arguments, kw_arguments);
+}
+
+inline boost::future<void> wamp_session::publish(
+        const std::string& topic, const wamp_raw_payload& payload, const wamp_publish_options& options)
+{
+    return publish_event(topic, options, payload);
+}
+
+inline boost::future<void> wamp_session::publish(
+        const wamp_uri& topic, const wamp_raw_payload& payload, const wamp_publish_options& options)
+{
+    return publish_event(topic, options, payload);
+}
+
+inline boost::future<wamp_subscription> wamp_session::subscribe(
+        const std::string& topic,
+        const wamp_event_handler& handler,
+        const wamp_subscribe_options& options)
+{
+    return subscribe_topic(topic, handler, options);
+}
+
+inline boost::future<wamp_subscription> wamp_session::subscribe(
+        const wamp_uri& topic,
+        const wamp_event_handler& handler,
+        const wamp_subscribe_options& options)
+{
+    return subscribe_topic(topic, handler, options);
+}
+
+inline boost::future<void> wamp_session::unsubscribe(const wamp_subscription& subscription)
 {
     uint64_t request_id = ++m_request_id;
 
-    auto message = std::make_shared<wamp_message>(4);
-    message->set_field(0, static_cast<int>(message_type::PUBLISH));
+    auto message = std::make_shared<wamp_message>(3, m_zone_pool);
+    message->set_field(0, static_cast<int>(message_type::UNSUBSCRIBE));
     message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, topic);
+    message->set_field(2, subscription.id());
 
-    auto result = std::make_shared<boost::promise<void>>();
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+    auto unsubscribe_request = std::make_shared<wamp_unsubscribe_request>(subscription);
 
-    m_io_service.dispatch([this, weak_self, message, result]() {
+    m_io_service.dispatch([this, weak_self, message, request_id, unsubscribe_request]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
@@ -258,231 +281,741 @@ inline boost::future<void> wamp_session::publish(const std::string& topic,const
 
         try {
             send_message(std::move(*message));
-            result->set_value();
+            m_unsubscribe_requests.emplace(request_id, unsubscribe_request);
         } catch (const std::exception& e) {
-            result->set_exception(boost::copy_exception(e));
+            unsubscribe_request->response().set_exception(boost::copy_exception(e));
         }
     });
 
-    return result->get_future();
-}
+    return unsubscribe_request->response().get_future();
+}
+
+inline boost::future<wamp_call_result> wamp_session::call(
+        const std::string& procedure,
+        const wamp_call_options& options)
+{
+    return call_procedure(procedure, options);
+}
+
+template<typename List>
+inline boost::future<wamp_call_result> wamp_session::call(
+        const std::string& procedure,
+        const List& arguments,
+        const wamp_call_options& options)
+{
+    return call_procedure(procedure, options, arguments);
+}
+
+template<typename List, typename Map>
+inline boost::future<wamp_call_result> wamp_session::call(
+        const std::string& procedure,
+        const List& arguments,
+        const Map& kw_arguments,
+        const wamp_call_options& options)
+{
+    return call_procedure(procedure, options, arguments, kw_arguments);
+}
+
+inline boost::future<wamp_call_result> wamp_session::call(
+        const wamp_uri& procedure,
+        const wamp_call_options& options)
+{
+    return call_procedure(procedure, options);
+}
+
+template<typename List>
+inline boost::future<wamp_call_result> wamp_session::call(
+        const wamp_uri& procedure,
+        const List& arguments,
+        const wamp_call_options& options)
+{
+    return call_procedure(procedure, options, arguments);
+}
+
+template<typename List, typename Map>
+inline boost::future<wamp_call_result> wamp_session::call(
+        const wamp_uri& procedure,
+        const List& arguments,
+        const Map& kw_arguments,
+        const wamp_call_options& options)
+{
+    return call_procedure(procedure, options, arguments, kw_arguments);
+}
+
+inline boost::future<wamp_call_result> wamp_session::call(
+        const std::string& procedure,
+        const wamp_raw_payload& payload,
+        const wamp_call_options& options)
+{
+    return call_procedure(procedure, options, payload);
+}
+
+inline boost::future<wamp_call_result> wamp_session::call(
+        const wamp_uri& procedure,
+        const wamp_raw_payload& payload,
+        const wamp_call_options& options)
+{
+    return call_procedure(procedure, options, payload);
+}
+
+inline boost::future<wamp_registration> wamp_session::provide(
+        const std::string& name,
+        const wamp_procedure& procedure,
+        const provide_options& options)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto message = std::make_shared<wamp_message>(4, m_zone_pool);
+    message->set_field(0, static_cast<int>(message_type::REGISTER));
+    message->set_field(1, request_id);
+    message->set_field(2, options);
+    message->set_field(3, name);
+
+    using completion_type = wamp_promise_completion<wamp_registration>;
+    auto register_request = std::make_shared<wamp_basic_register_request<completion_type>>(
+            procedure, completion_type());
+    auto response = register_request->completion().get_future();
+
+    start_register(request_id, message, register_request);
+
+    return response;
+}
+
+inline boost::future<void> wamp_session::unprovide(const wamp_registration& registration)
+{
+    uint64_t request_id = ++m_request_id;
+
+	auto message = std::make_shared<wamp_message>(3, m_zone_pool);
+	message->set_field(0, static_cast<int>(message_type::UNREGISTER));
+	message->set_field(1, request_id);
+	message->set_field(2, registration.id());
+
+	auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+	auto unregister_request = std::make_shared<wamp_unregister_request>(registration);
+
+	m_io_service.dispatch([this, weak_self, message, request_id, unregister_request]() {
+		auto shared_self = weak_self.lock();
+		if (!shared_self) {
+			return;
+		}
+
+		try {
+			send_message(std::move(*message));
+			m_unregister_requests.emplace(request_id, unregister_request);
+		}
+		catch (const std::exception& e) {
+			unregister_request->response().set_exception(boost::copy_exception(e));
+		}
+	});
+
+	return unregister_request->response().get_future();
+}
+
+struct wamp_session::publish_initiation
+{
+    std::shared_ptr<wamp_session> session;
+
+    template <typename Handler>
+    void operator()(Handler&& handler, wamp_message&& message) const
+    {
+        using handler_type = typename std::decay<Handler>::type;
+        using completion_type = wamp_handler_completion<void, handler_type>;
+        boost::asio::dispatch(session->m_io_service, publish_operation<completion_type>(
+                session, std::move(message),
+                completion_type(handler_type(std::forward<Handler>(handler)), session->m_io_service)));
+    }
+};
+
+template <typename Completion>
+class wamp_session::publish_operation
+{
+public:
+    publish_operation(const std::shared_ptr<wamp_session>& session, wamp_message&& message, Completion&& completion)
+        : m_session(session)
+        , m_message(std::move(message))
+        , m_completion(std::move(completion))
+    {
+    }
+
+    void operator()()
+    {
+        auto shared_self = m_session.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        try {
+            shared_self->send_message(std::move(m_message));
+            m_completion.set_value();
+        } catch (const std::exception&) {
+            m_completion.set_exception(current_wamp_exception());
+        }
+    }
+
+private:
+    std::weak_ptr<wamp_session> m_session;
+    wamp_message m_message;
+    Completion m_completion;
+};
+
+struct wamp_session::subscribe_initiation
+{
+    std::shared_ptr<wamp_session> session;
+
+    template <typename Handler>
+    void operator()(Handler&& handler, uint64_t request_id,
+            const std::shared_ptr<wamp_message>& message, const wamp_event_handler& event_handler) const
+    {
+        using handler_type = typename std::decay<Handler>::type;
+        using completion_type = wamp_handler_completion<wamp_subscription, handler_type>;
+        auto subscribe_request = std::make_shared<wamp_basic_subscribe_request<completion_type>>(
+                event_handler,
+                completion_type(handler_type(std::forward<Handler>(handler)), session->m_io_service));
+
+        session->start_subscribe(request_id, message, subscribe_request);
+    }
+};
+
+struct wamp_session::call_initiation
+{
+    std::shared_ptr<wamp_session> session;
+
+    template <typename Handler>
+    void operator()(Handler&& handler, uint64_t request_id,
+            std::chrono::milliseconds timeout, wamp_message&& message) const
+    {
+        using handler_type = typename std::decay<Handler>::type;
+        using completion_type = wamp_handler_completion<wamp_call_result, handler_type>;
+        using call_type = wamp_basic_call<completion_type>;
+        auto call = std::allocate_shared<call_type>(
+                wamp_slab_allocator<call_type>(session->m_call_slab),
+                std::move(message),
+                timeout,
+                completion_type(handler_type(std::forward<Handler>(handler)), session->m_io_service));
+
+        session->start_call(request_id, call);
+    }
+};
+
+struct wamp_session::register_initiation
+{
+    std::shared_ptr<wamp_session> session;
+
+    template <typename Handler>
+    void operator()(Handler&& handler, uint64_t request_id,
+            const std::shared_ptr<wamp_message>& message, const wamp_procedure& procedure) const
+    {
+        using handler_type = typename std::decay<Handler>::type;
+        using completion_type = wamp_handler_completion<wamp_registration, handler_type>;
+        auto register_request = std::make_shared<wamp_basic_register_request<completion_type>>(
+                procedure,
+                completion_type(handler_type(std::forward<Handler>(handler)), session->m_io_service));
+
+        session->start_register(request_id, message, register_request);
+    }
+};
+
+struct wamp_session::join_initiation
+{
+    std::shared_ptr<wamp_session> session;
+
+    template <typename Handler>
+    void operator()(Handler&& handler, const std::shared_ptr<wamp_message>& message) const
+    {
+        using handler_type = typename std::decay<Handler>::type;
+        using completion_type = wamp_handler_completion<uint64_t, handler_type>;
+        auto join_request = std::make_shared<wamp_basic_join_request<completion_type>>(
+                completion_type(handler_type(std::forward<Handler>(handler)), session->m_io_service));
+
+        session->start_join(message, join_request);
+    }
+};
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, uint64_t))
+wamp_session::async_join(const std::string& realm, CompletionToken&& token)
+{
+    return async_join(realm, std::vector<std::string>(), std::string(),
+            std::map<std::string, std::string>(), std::forward<CompletionToken>(token));
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, uint64_t))
+wamp_session::async_join(
+        const std::string& realm,
+        const std::vector<std::string>& authentication_methods,
+        const std::string& authentication_id,
+        const std::map<std::string, std::string>& authentication_extra,
+        CompletionToken&& token)
+{
+    auto message = make_hello_message(realm, authentication_methods, authentication_id, authentication_extra);
+
+    return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, uint64_t)>(
+            join_initiation{this->shared_from_this()}, token, message);
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+wamp_session::async_publish(const std::string& topic, const wamp_publish_options& options, CompletionToken&& token)
+{
+    return async_publish_event(std::forward<CompletionToken>(token), topic, options);
+}
+
+template <typename List, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+wamp_session::async_publish(const std::string& topic, const List& arguments,
+        const wamp_publish_options& options, CompletionToken&& token)
+{
+    return async_publish_event(std::forward<CompletionToken>(token), topic, options, arguments);
+}
+
+template <typename List, typename Map, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+wamp_session::async_publish(const std::string& topic, const List& arguments, const Map& kw_arguments,
+        const wamp_publish_options& options, CompletionToken&& token)
+{
+    return async_publish_event(std::forward<CompletionToken>(token), topic, options, arguments, kw_arguments);
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+wamp_session::async_publish(const wamp_uri& topic, const wamp_publish_options& options, CompletionToken&& token)
+{
+    return async_publish_event(std::forward<CompletionToken>(token), topic, options);
+}
+
+template <typename List, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+wamp_session::async_publish(const wamp_uri& topic, const List& arguments,
+        const wamp_publish_options& options, CompletionToken&& token)
+{
+    return async_publish_event(std::forward<CompletionToken>(token), topic, options, arguments);
+}
+
+template <typename List, typename Map, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+wamp_session::async_publish(const wamp_uri& topic, const List& arguments, const Map& kw_arguments,
+        const wamp_publish_options& options, CompletionToken&& token)
+{
+    return async_publish_event(std::forward<CompletionToken>(token), topic, options, arguments, kw_arguments);
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_subscription))
+wamp_session::async_subscribe(const std::string& topic, const wamp_event_handler& handler,
+        const wamp_subscribe_options& options, CompletionToken&& token)
+{
+    return async_subscribe_topic(std::forward<CompletionToken>(token), topic, handler, options);
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_subscription))
+wamp_session::async_subscribe(const wamp_uri& topic, const wamp_event_handler& handler,
+        const wamp_subscribe_options& options, CompletionToken&& token)
+{
+    return async_subscribe_topic(std::forward<CompletionToken>(token), topic, handler, options);
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+wamp_session::async_call(const std::string& procedure, const wamp_call_options& options, CompletionToken&& token)
+{
+    return async_call_procedure(std::forward<CompletionToken>(token), procedure, options);
+}
+
+template <typename List, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+wamp_session::async_call(const std::string& procedure, const List& arguments,
+        const wamp_call_options& options, CompletionToken&& token)
+{
+    return async_call_procedure(std::forward<CompletionToken>(token), procedure, options, arguments);
+}
+
+template <typename List, typename Map, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+wamp_session::async_call(const std::string& procedure, const List& arguments, const Map& kw_arguments,
+        const wamp_call_options& options, CompletionToken&& token)
+{
+    return async_call_procedure(std::forward<CompletionToken>(token), procedure, options, arguments, kw_arguments);
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+wamp_session::async_call(const wamp_uri& procedure, const wamp_call_options& options, CompletionToken&& token)
+{
+    return async_call_procedure(std::forward<CompletionToken>(token), procedure, options);
+}
+
+template <typename List, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+wamp_session::async_call(const wamp_uri& procedure, const List& arguments,
+        const wamp_call_options& options, CompletionToken&& token)
+{
+    return async_call_procedure(std::forward<CompletionToken>(token), procedure, options, arguments);
+}
+
+template <typename List, typename Map, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+wamp_session::async_call(const wamp_uri& procedure, const List& arguments, const Map& kw_arguments,
+        const wamp_call_options& options, CompletionToken&& token)
+{
+    return async_call_procedure(std::forward<CompletionToken>(token), procedure, options, arguments, kw_arguments);
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_registration))
+wamp_session::async_provide(const std::string& uri, const wamp_procedure& procedure,
+        const provide_options& options, CompletionToken&& token)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto message = std::make_shared<wamp_message>(4, m_zone_pool);
+    message->set_field(0, static_cast<int>(message_type::REGISTER));
+    message->set_field(1, request_id);
+    message->set_field(2, options);
+    message->set_field(3, uri);
+
+    return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, wamp_registration)>(
+            register_initiation{this->shared_from_this()}, token, request_id, message, procedure);
+}
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+namespace detail {
+
+// Runs a coroutine procedure from a copy of it that lives in the coroutine
+// frame, so that the procedure outlives its registration if it has to.
+inline boost::asio::awaitable<void> run_wamp_coroutine_procedure(
+        wamp_coroutine_procedure procedure, wamp_invocation invocation)
+{
+    co_await procedure(std::move(invocation));
+}
+
+} // namespace detail
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_registration))
+wamp_session::async_provide_coroutine(const std::string& uri, const wamp_coroutine_procedure& procedure,
+        const provide_options& options, CompletionToken&& token)
+{
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+
+    // Invocations are processed on the io service, so the coroutine is
+    // started right there and needs no further hop to reply.
+    wamp_procedure spawn_procedure = [weak_self, procedure](wamp_invocation invocation) {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        // The procedure is copied into the coroutine, as unprovide() or a
+        // failed transport may destroy this handler while it is suspended.
+        boost::asio::co_spawn(shared_self->m_io_service,
+                detail::run_wamp_coroutine_procedure(procedure, invocation),
+                [invocation](std::exception_ptr exception) {
+            if (!exception || !invocation->sendable()) {
+                return;
+            }
+
+            try {
+                std::rethrow_exception(exception);
+            }
+            catch (const std::exception& e) {
+                std::map<std::string, std::string> error_kw_arguments;
+                error_kw_arguments["what"] = e.what();
+                invocation->error("wamp.error.runtime_error", EMPTY_ARGUMENTS, error_kw_arguments);
+            }
+            catch (...) {
+                invocation->error("wamp.error.runtime_error");
+            }
+        });
+    };
+
+    return async_provide(uri, spawn_procedure, options, std::forward<CompletionToken>(token));
+}
+#endif
+
+inline boost::future<wamp_authenticate> wamp_session::on_challenge(const wamp_challenge& /*challenge*/)
+{
+    // a dummy implementation
+    boost::promise<wamp_authenticate> dummy;
+    dummy.set_value( wamp_authenticate( "" ) );
+    return dummy.get_future();
+}
+
+template <typename Topic, typename... Arguments>
+inline boost::future<void> wamp_session::publish_event(
+        const Topic& topic, const wamp_publish_options& options, const Arguments&... arguments)
+{
+    uint64_t request_id = ++m_request_id;
+
+    wamp_promise_completion<void> completion;
+    auto result = completion.get_future();
+
+    boost::asio::dispatch(m_io_service, publish_operation<wamp_promise_completion<void>>(
+            this->shared_from_this(),
+            encode_wamp_message(m_zone_pool,
+                    static_cast<int>(message_type::PUBLISH), request_id, options, topic, arguments...),
+            std::move(completion)));
+
+    return result;
+}
+
+template <typename Topic>
+inline boost::future<wamp_subscription> wamp_session::subscribe_topic(
+        const Topic& topic,
+        const wamp_event_handler& handler,
+        const wamp_subscribe_options& options)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto message = std::make_shared<wamp_message>(encode_wamp_message(m_zone_pool,
+            static_cast<int>(message_type::SUBSCRIBE), request_id, options, topic));
+
+    using completion_type = wamp_promise_completion<wamp_subscription>;
+    auto subscribe_request = std::make_shared<wamp_basic_subscribe_request<completion_type>>(
+            handler, completion_type());
+    auto response = subscribe_request->completion().get_future();
+
+    start_subscribe(request_id, message, subscribe_request);
+
+    return response;
+}
+
+template <typename Procedure, typename... Arguments>
+inline boost::future<wamp_call_result> wamp_session::call_procedure(
+        const Procedure& procedure, const wamp_call_options& options, const Arguments&... arguments)
+{
+    uint64_t request_id = ++m_request_id;
+
+    // The call record, which holds the CALL message until it is sent,
+    // comes from the slab.
+    using call_type = wamp_basic_call<wamp_promise_completion<wamp_call_result>>;
+    auto call = std::allocate_shared<call_type>(
+            wamp_slab_allocator<call_type>(m_call_slab),
+            encode_wamp_message(m_zone_pool, static_cast<int>(message_type::CALL), request_id, options, procedure, arguments...),
+            options.timeout(),
+            wamp_promise_completion<wamp_call_result>());
+    auto result = call->completion().get_future();
+
+    start_call(request_id, call);
+
+    return result;
+}
+
+template <typename CompletionToken, typename Topic, typename... Arguments>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code))
+wamp_session::async_publish_event(CompletionToken&& token,
+        const Topic& topic, const wamp_publish_options& options, const Arguments&... arguments)
+{
+    uint64_t request_id = ++m_request_id;
+
+    return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code)>(
+            publish_initiation{this->shared_from_this()}, token,
+            encode_wamp_message(m_zone_pool, static_cast<int>(message_type::PUBLISH), request_id, options, topic, arguments...));
+}
+
+template <typename CompletionToken, typename Topic>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_subscription))
+wamp_session::async_subscribe_topic(CompletionToken&& token,
+        const Topic& topic, const wamp_event_handler& handler, const wamp_subscribe_options& options)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto message = std::make_shared<wamp_message>(encode_wamp_message(m_zone_pool,
+            static_cast<int>(message_type::SUBSCRIBE), request_id, options, topic));
+
+    return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, wamp_subscription)>(
+            subscribe_initiation{this->shared_from_this()}, token, request_id, message, handler);
+}
+
+template <typename CompletionToken, typename Procedure, typename... Arguments>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(boost::system::error_code, wamp_call_result))
+wamp_session::async_call_procedure(CompletionToken&& token,
+        const Procedure& procedure, const wamp_call_options& options, const Arguments&... arguments)
+{
+    uint64_t request_id = ++m_request_id;
+
+    return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, wamp_call_result)>(
+            call_initiation{this->shared_from_this()}, token, request_id, options.timeout(),
+            encode_wamp_message(m_zone_pool, static_cast<int>(message_type::CALL), request_id, options, procedure, arguments...));
+}
+
+inline std::shared_ptr<wamp_message> wamp_session::make_hello_message(
+        const std::string& realm,
+        const std::vector<std::string>& authentication_methods,
+        const std::string& authentication_id,
+        const std::map<std::string, std::string>& authentication_extra)
+{
+    msgpack::zone zone;
+    std::unordered_map<std::string, msgpack::object> roles;
+
+    std::unordered_map<std::string, bool> caller_features;
+    caller_features["call_timeout"] = true;
+    std::unordered_map<std::string, msgpack::object> caller;
+    caller["features"] = msgpack::object(caller_features, zone);
+    roles["caller"] = msgpack::object(caller, zone);
+
+    std::unordered_map<std::string, bool> callee_features;
+    callee_features["call_timeout"] = true;
+    std::unordered_map<std::string, msgpack::object> callee;
+    callee["features"] = msgpack::object(callee_features, zone);
+    roles["callee"] = msgpack::object(callee, zone);
 
-template <typename List>
-inline boost::future<void> wamp_session::publish(const std::string& topic, const List& arguments,const wamp_publish_options& options)
-{
-    uint64_t request_id = ++m_request_id;
+    std::unordered_map<std::string, msgpack::object> publisher;
+    roles["publisher"] = msgpack::object(publisher, zone);
 
-    auto message = std::make_shared<wamp_message>(5);
-    message->set_field(0, static_cast<int>(message_type::PUBLISH));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, topic);
-    message->set_field(4, arguments);
+    std::unordered_map<std::string, msgpack::object> subscriber;
+    roles["subscriber"] = msgpack::object(subscriber, zone);
 
-    auto result = std::make_shared<boost::promise<void>>();
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+    std::unordered_map<std::string, msgpack::object> details;
+    details["roles"] = msgpack::object(roles, zone);
+    details["authmethods"] = msgpack::object(authentication_methods, zone);
+    details["authid"] = msgpack::object(authentication_id, zone);
 
-    m_io_service.dispatch([this, weak_self, message, result]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
+    if (!authentication_extra.empty()) {
+      std::unordered_map<std::string, msgpack::object> authextra;
+      for (auto const &a : authentication_extra) {
+        authextra[a.first] = msgpack::object(a.second, zone);
+      }
+      details["authextra"] = msgpack::object(authextra, zone);
+    }
 
-        try {
-            send_message(std::move(*message));
-            result->set_value();
-        } catch (const std::exception& e) {
-            result->set_exception(boost::copy_exception(e));
-        }
-    });
+    auto message = std::make_shared<wamp_message>(3, std::move(zone));
+    message->set_field(0, static_cast<int>(message_type::HELLO));
+    message->set_field(1, realm);
+    message->set_field(2, details);
 
-    return result->get_future();
+    return message;
 }
 
-template <typename List, typename Map>
-inline boost::future<void> wamp_session::publish(
-        const std::string& topic, const List& arguments, const Map& kw_arguments,const wamp_publish_options& options)
+inline void wamp_session::start_join(
+        const std::shared_ptr<wamp_message>& message,
+        const std::shared_ptr<wamp_join_request>& join_request)
 {
-    uint64_t request_id = ++m_request_id;
-
-    auto message = std::make_shared<wamp_message>(6);
-    message->set_field(0, static_cast<int>(message_type::PUBLISH));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, topic);
-    message->set_field(4, arguments);
-    message->set_field(5, kw_arguments);
-
-    auto result = std::make_shared<boost::promise<void>>();
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
 
-    m_io_service.dispatch([this, weak_self, message, result]() {
+    m_io_service.dispatch([this, weak_self, message, join_request]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
         }
 
-        try {
-            send_message(std::move(*message));
-            result->set_value();
-        } catch (const std::exception& e) {
-            result->set_exception(boost::copy_exception(e));
+        if (m_session_id) {
+            join_request->set_exception(boost::copy_exception(protocol_error("session already joined")));
+            return;
         }
-    });
-
-    return result->get_future();
-}
-
-inline boost::future<wamp_subscription> wamp_session::subscribe(
-        const std::string& topic,
-        const wamp_event_handler& handler,
-        const wamp_subscribe_options& options)
-{
-    uint64_t request_id = ++m_request_id;
-
-    auto message = std::make_shared<wamp_message>(4);
-    message->set_field(0, static_cast<int>(message_type::SUBSCRIBE));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, topic);
-
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto subscribe_request = std::make_shared<wamp_subscribe_request>(handler);
 
-    m_io_service.dispatch([this, weak_self, message, request_id, subscribe_request]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
+        if (m_join_request) {
+            join_request->set_exception(boost::copy_exception(protocol_error("session is already joining")));
             return;
         }
 
         try {
-            send_message(std::move(*message));
-            m_subscribe_requests.emplace(request_id, subscribe_request);
-        } catch (const std::exception& e) {
-            subscribe_request->response().set_exception(boost::copy_exception(e));
+            send_message(std::move(*message), false);
+            m_join_request = join_request;
+        } catch (const std::exception&) {
+            join_request->set_exception(current_wamp_exception());
         }
     });
-
-    return subscribe_request->response().get_future();
 }
 
-inline boost::future<void> wamp_session::unsubscribe(const wamp_subscription& subscription)
+inline void wamp_session::start_call(uint64_t request_id, const std::shared_ptr<wamp_call>& call)
 {
-    uint64_t request_id = ++m_request_id;
-
-    auto message = std::make_shared<wamp_message>(3);
-    message->set_field(0, static_cast<int>(message_type::UNSUBSCRIBE));
-    message->set_field(1, request_id);
-    message->set_field(2, subscription.id());
-
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto unsubscribe_request = std::make_shared<wamp_unsubscribe_request>(subscription);
 
-    m_io_service.dispatch([this, weak_self, message, request_id, unsubscribe_request]() {
+    m_io_service.dispatch([this, weak_self, request_id, call]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
         }
 
         try {
-            send_message(std::move(*message));
-            m_unsubscribe_requests.emplace(request_id, unsubscribe_request);
-        } catch (const std::exception& e) {
-            unsubscribe_request->response().set_exception(boost::copy_exception(e));
+            send_message(call->message());
+            m_calls.emplace(request_id, call);
+        } catch (const std::exception&) {
+            call->set_exception(current_wamp_exception());
+            return;
         }
-    });
 
-    return unsubscribe_request->response().get_future();
+        if (call->timeout().count() > 0) {
+            m_call_timeouts.schedule(call->timeout_node(), request_id,
+                    wamp_timer_wheel::clock::now() + call->timeout());
+            arm_call_timeout_timer();
+        }
+    });
 }
 
-inline boost::future<wamp_call_result> wamp_session::call(
-        const std::string& procedure,
-        const wamp_call_options& options)
+inline void wamp_session::process_call_timeout(uint64_t request_id)
 {
-    uint64_t request_id = ++m_request_id;
+    std::shared_ptr<wamp_call>* pending_call = m_calls.find(request_id);
+    if (!pending_call) {
+        return;
+    }
 
-    auto message = std::make_shared<wamp_message>(4);
-    message->set_field(0, static_cast<int>(message_type::CALL));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, procedure);
+    // The router never confirmed the cancellation, give up on it.
+    if ((*pending_call)->timed_out()) {
+        m_calls.erase(request_id);
+        return;
+    }
 
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto call = std::make_shared<wamp_call>();
+    std::shared_ptr<wamp_call> call = *pending_call;
+    call->set_timed_out();
+    m_call_timeouts.schedule(call->timeout_node(), request_id,
+            wamp_timer_wheel::clock::now() + call->timeout());
 
-    m_io_service.dispatch([this, weak_self, message, request_id, call]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
+    // [CANCEL, CALL.Request|id, Options|dict]
+    wamp_message message(3, m_zone_pool);
+    message.set_field(0, static_cast<int>(message_type::CANCEL));
+    message.set_field(1, request_id);
+    message.set_field(2, std::unordered_map<int, int>() /* No Options/Dict */);
 
-        try {
-            send_message(std::move(*message));
-            m_calls.emplace(request_id, call);
-        } catch (const std::exception& e) {
-            call->result().set_exception(boost::copy_exception(e));
+    try {
+        send_message(std::move(message));
+    } catch (const std::exception&) {
+        if (m_debug_enabled) {
+            std::cerr << "failed to cancel call " << request_id << std::endl;
         }
-    });
+    }
 
-    return call->result().get_future();
+    call->set_exception(boost::copy_exception(timeout_error("call timed out")));
 }
 
-template<typename List>
-inline boost::future<wamp_call_result> wamp_session::call(
-        const std::string& procedure,
-        const List& arguments,
-        const wamp_call_options& options)
+inline void wamp_session::arm_call_timeout_timer()
 {
-    uint64_t request_id = ++m_request_id;
-
-    auto message = std::make_shared<wamp_message>(5);
-    message->set_field(0, static_cast<int>(message_type::CALL));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, procedure);
-    message->set_field(4, arguments);
+    if (m_call_timeout_timer_armed || m_call_timeouts.empty()) {
+        return;
+    }
 
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto call = std::make_shared<wamp_call>();
 
-    m_io_service.dispatch([this, weak_self, message, request_id, call]() {
+    m_call_timeout_timer_armed = true;
+    m_call_timeout_timer.expires_at(m_call_timeouts.next_tick());
+    m_call_timeout_timer.async_wait([this, weak_self](const boost::system::error_code& error) {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
         }
 
-        try {
-            send_message(std::move(*message));
-            m_calls.emplace(request_id, call);
-        } catch (const std::exception& e) {
-            call->result().set_exception(boost::copy_exception(e));
+        m_call_timeout_timer_armed = false;
+        if (error) {
+            return;
         }
-    });
 
-    return call->result().get_future();
+        m_call_timeouts.advance(wamp_timer_wheel::clock::now(), [this](uint64_t request_id) {
+            process_call_timeout(request_id);
+        });
+        arm_call_timeout_timer();
+    });
 }
 
-template<typename List, typename Map>
-inline boost::future<wamp_call_result> wamp_session::call(
-        const std::string& procedure,
-        const List& arguments,
-        const Map& kw_arguments,
-        const wamp_call_options& options)
+inline void wamp_session::start_subscribe(
+        uint64_t request_id,
+        const std::shared_ptr<wamp_message>& message,
+        const std::shared_ptr<wamp_subscribe_request>& subscribe_request)
 {
-    uint64_t request_id = ++m_request_id;
-
-    auto message = std::make_shared<wamp_message>(6);
-    message->set_field(0, static_cast<int>(message_type::CALL));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, procedure);
-    message->set_field(4, arguments);
-    message->set_field(5, kw_arguments);
-
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto call = std::make_shared<wamp_call>();
 
-    m_io_service.dispatch([this, weak_self, message, request_id, call]() {
+    m_io_service.dispatch([this, weak_self, message, request_id, subscribe_request]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
@@ -490,30 +1023,19 @@ inline boost::future<wamp_call_result> wamp_session::call(
 
         try {
             send_message(std::move(*message));
-            m_calls.emplace(request_id, call);
-        } catch (const std::exception& e) {
-            call->result().set_exception(boost::copy_exception(e));
+            m_subscribe_requests.emplace(request_id, subscribe_request);
+        } catch (const std::exception&) {
+            subscribe_request->set_exception(current_wamp_exception());
         }
     });
-
-    return call->result().get_future();
 }
 
-inline boost::future<wamp_registration> wamp_session::provide(
-        const std::string& name,
-        const wamp_procedure& procedure,
-        const provide_options& options)
+inline void wamp_session::start_register(
+        uint64_t request_id,
+        const std::shared_ptr<wamp_message>& message,
+        const std::shared_ptr<wamp_register_request>& register_request)
 {
-    uint64_t request_id = ++m_request_id;
-
-    auto message = std::make_shared<wamp_message>(4);
-    message->set_field(0, static_cast<int>(message_type::REGISTER));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, name);
-
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto register_request = std::make_shared<wamp_register_request>(procedure);
 
     m_io_service.dispatch([this, weak_self, message, request_id, register_request]() {
         auto shared_self = weak_self.lock();
@@ -524,50 +1046,10 @@ inline boost::future<wamp_registration> wamp_session::provide(
         try {
             send_message(std::move(*message));
             m_register_requests.emplace(request_id, register_request);
-        } catch (const std::exception& e) {
-            register_request->response().set_exception(boost::copy_exception(e));
+        } catch (const std::exception&) {
+            register_request->set_exception(current_wamp_exception());
         }
     });
-
-    return register_request->response().get_future();
-}
-
-inline boost::future<void> wamp_session::unprovide(const wamp_registration& registration)
-{
-    uint64_t request_id = ++m_request_id;
-
-	auto message = std::make_shared<wamp_message>(3);
-	message->set_field(0, static_cast<int>(message_type::UNREGISTER));
-	message->set_field(1, request_id);
-	message->set_field(2, registration.id());
-
-	auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-	auto unregister_request = std::make_shared<wamp_unregister_request>(registration);
-
-	m_io_service.dispatch([this, weak_self, message, request_id, unregister_request]() {
-		auto shared_self = weak_self.lock();
-		if (!shared_self) {
-			return;
-		}
-
-		try {
-			send_message(std::move(*message));
-			m_unregister_requests.emplace(request_id, unregister_request);
-		}
-		catch (const std::exception& e) {
-			unregister_request->response().set_exception(boost::copy_exception(e));
-		}
-	});
-
-	return unregister_request->response().get_future();
-}
-
-inline boost::future<wamp_authenticate> wamp_session::on_challenge(const wamp_challenge& /*challenge*/)
-{
-    // a dummy implementation
-    boost::promise<wamp_authenticate> dummy;
-    dummy.set_value( wamp_authenticate( "" ) );
-    return dummy.get_future();
 }
 
 inline void wamp_session::on_attach(const std::shared_ptr<wamp_transport>& transport)
@@ -588,7 +1070,7 @@ inline void wamp_session::on_attach(const std::shared_ptr<wamp_transport>& trans
     m_transport = transport;
 }
 
-inline void wamp_session::on_detach(bool /*was_clean*/, const std::string& /*reason*/)
+inline void wamp_session::on_detach(bool was_clean, const std::string& reason)
 {
     // FIXME: We should be deferring this operation to the io service. This
     //        will almost certainly require us to return a future here to
@@ -606,9 +1088,62 @@ inline void wamp_session::on_detach(bool /*was_clean*/, const std::string& /*rea
     //        One side effect here will be if the transport is re-used for
     //        another session as it may still receive messages for the old
     //        session.
-    assert(!m_running);
+    if (was_clean) {
+        assert(!m_running);
+        m_transport.reset();
+        return;
+    }
 
+    // The transport failed, so none of the outstanding requests is going to
+    // be answered. Fail them instead of leaving their callers waiting.
     m_transport.reset();
+    m_running = false;
+    m_session_id = 0;
+
+    const auto exception = boost::copy_exception(network_error(reason));
+
+    std::shared_ptr<wamp_join_request> join_request;
+    m_join_request.swap(join_request);
+    if (join_request) {
+        join_request->set_exception(exception);
+    }
+
+    wamp_id_map<std::shared_ptr<wamp_call>> calls;
+    m_calls.swap(calls);
+    calls.for_each([&](uint64_t, std::shared_ptr<wamp_call>& call) {
+        m_call_timeouts.cancel(call->timeout_node());
+        if (!call->timed_out()) {
+            call->set_exception(exception);
+        }
+    });
+
+    wamp_id_map<std::shared_ptr<wamp_subscribe_request>> subscribe_requests;
+    m_subscribe_requests.swap(subscribe_requests);
+    subscribe_requests.for_each([&](uint64_t, std::shared_ptr<wamp_subscribe_request>& request) {
+        request->set_exception(exception);
+    });
+
+    wamp_id_map<std::shared_ptr<wamp_unsubscribe_request>> unsubscribe_requests;
+    m_unsubscribe_requests.swap(unsubscribe_requests);
+    unsubscribe_requests.for_each([&](uint64_t, std::shared_ptr<wamp_unsubscribe_request>& request) {
+        request->response().set_exception(exception);
+    });
+
+    wamp_id_map<std::shared_ptr<wamp_register_request>> register_requests;
+    m_register_requests.swap(register_requests);
+    register_requests.for_each([&](uint64_t, std::shared_ptr<wamp_register_request>& request) {
+        request->set_exception(exception);
+    });
+
+    wamp_id_map<std::shared_ptr<wamp_unregister_request>> unregister_requests;
+    m_unregister_requests.swap(unregister_requests);
+    unregister_requests.for_each([&](uint64_t, std::shared_ptr<wamp_unregister_request>& request) {
+        request->response().set_exception(exception);
+    });
+
+    // Subscriptions and registrations end with the connection.
+    m_subscription_handlers.clear();
+    m_procedures.clear();
 }
 
 inline void wamp_session::on_message(wamp_message&& message)
@@ -801,18 +1336,40 @@ inline void wamp_session::process_challenge(wamp_message&& message)
                              "'wampcra', 'ticket' and 'cryptosign'");
     }
 
+    // call the context, to get a signature...
+    boost::future<wamp_authenticate> authenticate = on_challenge(challenge_object);
+
+    // A signature that is ready right away is sent from here, which spares
+    // the continuation below its thread and the hop back to the io service.
+    if (authenticate.is_ready()) {
+        try {
+            const wamp_authenticate sig = authenticate.get();
+
+            wamp_message response(3, m_zone_pool);
+            response.set_field(0, static_cast<int>(message_type::AUTHENTICATE));
+            response.set_field(1, sig.signature());
+            response.set_field(2, std::unordered_map<int, int>() /* No Extra/Dict */);
+            send_message(std::move(response), false);
+        } catch (const std::exception&) {
+            if (m_debug_enabled) {
+                std::cerr << "failed to handle authentication" << std::endl;
+            }
+            throw protocol_error("authentication error: failed send signature");
+        }
+        return;
+    }
+
     // I am not sure if this is neccesary. Looking at other
     // comments in this code and the examples, it seems like the
     // context_response should live at least until the end of
     // the lambda callback - below
     std::shared_ptr< boost::future< void > > context_response = std::make_shared< boost::future<void> >();
 
-    // call the context, to get a signature...
-    (*context_response) = on_challenge(challenge_object).then([this, context_response]( boost::future<wamp_authenticate> fu_auth) {
+    (*context_response) = authenticate.then([this, context_response]( boost::future<wamp_authenticate> fu_auth) {
         try {
             const wamp_authenticate sig = fu_auth.get();
 
-            auto message = std::make_shared<wamp_message>(3);
+            auto message = std::make_shared<wamp_message>(3, m_zone_pool);
             message->set_field(0, static_cast<int>(message_type::AUTHENTICATE));
             message->set_field(1, sig.signature());
             message->set_field(2, std::unordered_map<int, int>() /* No Extra/Dict */);
@@ -849,7 +1406,12 @@ inline void wamp_session::process_welcome(wamp_message&& message)
 {
     m_session_id = message.field<uint64_t>(1);
     message.field(2).convert(m_welcome_details);
-    m_session_join.set_value(m_session_id);
+
+    std::shared_ptr<wamp_join_request> join_request;
+    m_join_request.swap(join_request);
+    if (join_request) {
+        join_request->set_response(m_session_id);
+    }
 }
 
 inline void wamp_session::process_abort(wamp_message&& message)
@@ -871,7 +1433,12 @@ inline void wamp_session::process_abort(wamp_message&& message)
     }
 
     std::string uri = message.field<std::string>(2);
-    m_session_join.set_exception(boost::copy_exception(abort_error(uri)));
+
+    std::shared_ptr<wamp_join_request> join_request;
+    m_join_request.swap(join_request);
+    if (join_request) {
+        join_request->set_exception(boost::copy_exception(abort_error(uri)));
+    }
 }
 
 inline void wamp_session::process_goodbye(wamp_message&& message)
@@ -881,7 +1448,7 @@ inline void wamp_session::process_goodbye(wamp_message&& message)
     // if we did not initiate closing, reply ..
     if (!m_goodbye_sent) {
         // [GOODBYE, Details|dict, Reason|uri]
-        wamp_message goodbye(3);
+        wamp_message goodbye(3, m_zone_pool);
         goodbye.set_field(0, static_cast<int>(message_type::GOODBYE));
         goodbye.set_field(1, std::unordered_map<int,int>() /* No Details */);
         goodbye.set_field(2, std::string("wamp.error.goodbye_and_out"));
@@ -937,7 +1504,8 @@ inline void wamp_session::process_error(wamp_message&& message)
     if (!message.is_field_type(4, msgpack::type::STR)) {
         throw protocol_error("invalid ERROR message - Error must be a string (URI)");
     }
-    auto error = message.field<std::string>(4);
+    auto error_uri = message.field<std::string>(4);
+    std::string error = error_uri;
 
     // Arguments|list
     if (message.size() > 5) {
@@ -974,12 +1542,23 @@ inline void wamp_session::process_error(wamp_message&& message)
                 //
                 // process CALL ERROR
                 //
-                auto call_itr = m_calls.find(request_id);
-
-                if (call_itr != m_calls.end()) {
-                    // FIXME: Forward all error info.
-                    call_itr->second->result().set_exception(boost::copy_exception(std::runtime_error(error)));
-                    m_calls.erase(call_itr);
+                std::shared_ptr<wamp_call> call;
+                if (m_calls.extract(request_id, call)) {
+                    m_call_timeouts.cancel(call->timeout_node());
+
+                    // A call that timed out has failed already, this is
+                    // the router confirming its cancellation.
+                    if (!call->timed_out()) {
+                        wamp_call_result details(std::move(message.zone()));
+                        details.set_error(error_uri);
+                        if (message.size() > 5) {
+                            details.set_arguments(message.field(5));
+                        }
+                        if (message.size() > 6) {
+                            details.set_kw_arguments(message.field(6));
+                        }
+                        call->set_error(boost::copy_exception(wamp_error(error_uri, error)), std::move(details));
+                    }
                 } else {
                     throw protocol_error("bogus ERROR message for non-pending CALL request ID: " + error);
                 }
@@ -987,11 +1566,10 @@ inline void wamp_session::process_error(wamp_message&& message)
             break;
         case message_type::REGISTER:
             {
-                auto reg_itr = m_register_requests.find(request_id);
-                if (reg_itr != m_register_requests.end())
+                std::shared_ptr<wamp_register_request> register_request;
+                if (m_register_requests.extract(request_id, register_request))
                 {
-                    reg_itr->second->response().set_exception(boost::copy_exception(std::runtime_error(error)));
-                    m_register_requests.erase(reg_itr);
+                    register_request->set_exception(boost::copy_exception(wamp_error(error_uri, error)));
                 } else {
                     throw protocol_error("bogus ERROR message for non-pending REGISTER request ID: " + error);
                 }
@@ -999,11 +1577,10 @@ inline void wamp_session::process_error(wamp_message&& message)
             break;
         case message_type::UNREGISTER:
             {
-                auto unreg_itr = m_unregister_requests.find(request_id);
-                if (unreg_itr != m_unregister_requests.end())
+                std::shared_ptr<wamp_unregister_request> unregister_request;
+                if (m_unregister_requests.extract(request_id, unregister_request))
                 {
-                   unreg_itr->second->response().set_exception(boost::copy_exception(std::runtime_error(error)));
-                   m_unregister_requests.erase(unreg_itr);
+                    unregister_request->response().set_exception(boost::copy_exception(wamp_error(error_uri, error)));
                 } else {
                     throw protocol_error("bogus ERROR message for non-pending UNREGISTER request ID: " + error);
                 }
@@ -1019,11 +1596,10 @@ inline void wamp_session::process_error(wamp_message&& message)
             break;
         case message_type::SUBSCRIBE:
             {
-                auto sub_itr = m_subscribe_requests.find(request_id);
-                if (sub_itr != m_subscribe_requests.end())
+                std::shared_ptr<wamp_subscribe_request> subscribe_request;
+                if (m_subscribe_requests.extract(request_id, subscribe_request))
                 {
-                    sub_itr->second->response().set_exception(boost::copy_exception(std::runtime_error(error)));
-                    m_subscribe_requests.erase(sub_itr);
+                    subscribe_request->set_exception(boost::copy_exception(wamp_error(error_uri, error)));
                 } else {
                     throw protocol_error("bogus ERROR message for non-pending SUBSCRIBE request ID: " + error);
                 }
@@ -1031,11 +1607,10 @@ inline void wamp_session::process_error(wamp_message&& message)
             break;
         case message_type::UNSUBSCRIBE:
             {
-                auto unsub_itr = m_unsubscribe_requests.find(request_id);
-                if (unsub_itr != m_unsubscribe_requests.end())
+                std::shared_ptr<wamp_unsubscribe_request> unsubscribe_request;
+                if (m_unsubscribe_requests.extract(request_id, unsubscribe_request))
                 {
-                    unsub_itr->second->response().set_exception(boost::copy_exception(std::runtime_error(error)));
-                    m_unsubscribe_requests.erase(unsub_itr);
+                    unsubscribe_request->response().set_exception(boost::copy_exception(wamp_error(error_uri, error)));
                 } else {
                     throw protocol_error("bogus ERROR message for non-pending UNSUBSCRIBE request ID: " + error);
                 }
@@ -1068,8 +1643,8 @@ inline void wamp_session::process_invocation(wamp_message&& message)
     }
     uint64_t registration_id = message.field<uint64_t>(2);
 
-    auto procedure_itr = m_procedures.find(registration_id);
-    if (procedure_itr != m_procedures.end()) {
+    const wamp_procedure* procedure = m_procedures.find(registration_id);
+    if (procedure) {
         if (!message.is_field_type(3, msgpack::type::MAP)) {
             throw protocol_error("INVOCATION.Details must be a map");
         }
@@ -1091,7 +1666,16 @@ inline void wamp_session::process_invocation(wamp_message&& message)
             }
         }
 
+        // The packed arguments stay valid in the zone, which the message
+        // hands its packed form over to.
+        const char* payload_data = nullptr;
+        std::size_t payload_size = 0;
+        if (message.packed_fields(4, payload_data, payload_size)) {
+            invocation->set_raw_payload(wamp_raw_payload(payload_data, payload_size, message.size() - 4));
+        }
+
         invocation->set_zone(std::move(message.zone()));
+        invocation->set_zone_pool(m_zone_pool);
 
         auto weak_this = std::weak_ptr<wamp_session>(this->shared_from_this());
 
@@ -1119,7 +1703,7 @@ inline void wamp_session::process_invocation(wamp_message&& message)
             if (m_debug_enabled) {
                 std::cerr << "Invoking procedure registered under " << registration_id << std::endl;
             }
-            procedure_itr->second(invocation);
+            (*procedure)(invocation);
         }
 
         // FIXME: implement Autobahn-specific exception with error URI
@@ -1159,13 +1743,27 @@ inline void wamp_session::process_call_result(wamp_message&& message)
     }
     uint64_t request_id = message.field<uint64_t>(1);
 
-    auto call_itr = m_calls.find(request_id);
-    if (call_itr != m_calls.end()) {
+    std::shared_ptr<wamp_call> call;
+    if (m_calls.extract(request_id, call)) {
+        m_call_timeouts.cancel(call->timeout_node());
+
+        // The result came too late, the call has failed already.
+        if (call->timed_out()) {
+            return;
+        }
+
         if (!message.is_field_type(2, msgpack::type::MAP)) {
             throw protocol_error("RESULT - Details must be a dictionary");
         }
 
+        const char* payload_data = nullptr;
+        std::size_t payload_size = 0;
+        const bool packed = message.packed_fields(3, payload_data, payload_size);
+
         wamp_call_result result(std::move(message.zone()));
+        if (packed) {
+            result.set_raw_payload(wamp_raw_payload(payload_data, payload_size, message.size() - 3));
+        }
         if (message.size() > 3) {
             if (!message.is_field_type(3, msgpack::type::ARRAY)) {
                 throw protocol_error("RESULT - YIELD.Arguments must be a list");
@@ -1179,8 +1777,7 @@ inline void wamp_session::process_call_result(wamp_message&& message)
                 result.set_kw_arguments(message.field(4));
             }
         }
-        call_itr->second->set_result(std::move(result));
-        m_calls.erase(call_itr);
+        call->set_result(std::move(result));
     } else {
         throw protocol_error("bogus RESULT message for non-pending request ID");
     }
@@ -1198,17 +1795,15 @@ inline void wamp_session::process_subscribed(wamp_message&& message)
     }
     uint64_t request_id = message.field<uint64_t>(1);
 
-    auto subscribe_request_itr = m_subscribe_requests.find(request_id);
-    if (subscribe_request_itr != m_subscribe_requests.end()) {
+    std::shared_ptr<wamp_subscribe_request> subscribe_request;
+    if (m_subscribe_requests.extract(request_id, subscribe_request)) {
         if (!message.is_field_type(2, msgpack::type::POSITIVE_INTEGER)) {
             throw protocol_error("SUBSCRIBED - SUBSCRIBED.Subscription must be an integer");
         }
 
         uint64_t subscription_id = message.field<uint64_t>(2);
-        m_subscription_handlers.insert(
-                std::make_pair(subscription_id, subscribe_request_itr->second->handler()));
-        subscribe_request_itr->second->set_response(wamp_subscription(subscription_id));
-        m_subscribe_requests.erase(request_id);
+        m_subscription_handlers[subscription_id].push_back(subscribe_request->handler());
+        subscribe_request->set_response(wamp_subscription(subscription_id));
     } else {
         throw protocol_error("SUBSCRIBED - no pending request ID");
     }
@@ -1226,12 +1821,11 @@ inline void wamp_session::process_unsubscribed(wamp_message&& message)
     }
     uint64_t request_id = message.field<uint64_t>(1);
 
-    auto unsubscribe_request_itr = m_unsubscribe_requests.find(request_id);
-    if (unsubscribe_request_itr != m_unsubscribe_requests.end()) {
-        uint64_t subscription_id = unsubscribe_request_itr->second->subscription().id();
+    std::shared_ptr<wamp_unsubscribe_request> unsubscribe_request;
+    if (m_unsubscribe_requests.extract(request_id, unsubscribe_request)) {
+        uint64_t subscription_id = unsubscribe_request->subscription().id();
         m_subscription_handlers.erase(subscription_id);
-        unsubscribe_request_itr->second->set_response();
-        m_unsubscribe_requests.erase(request_id);
+        unsubscribe_request->set_response();
     } else {
         throw protocol_error("UNSUBSCRIBED - no pending request ID");
     }
@@ -1252,11 +1846,8 @@ inline void wamp_session::process_event(wamp_message&& message)
     }
     uint64_t subscription_id = message.field<uint64_t>(1);
 
-    auto subscription_handlers_itr = m_subscription_handlers.lower_bound(subscription_id);
-    auto subscription_handlers_end = m_subscription_handlers.upper_bound(subscription_id);
-
-    if (subscription_handlers_itr != m_subscription_handlers.end() &&
-            subscription_handlers_itr != subscription_handlers_end) {
+    const std::vector<wamp_event_handler>* subscription_handlers = m_subscription_handlers.find(subscription_id);
+    if (subscription_handlers) {
 
         if (!message.is_field_type(2, msgpack::type::POSITIVE_INTEGER)) {
             throw protocol_error("EVENT - PUBLISHED.Publication must be an id");
@@ -1267,30 +1858,27 @@ inline void wamp_session::process_event(wamp_message&& message)
             throw protocol_error("EVENT - Details must be a dictionary");
         }
 
-        wamp_event event = std::make_shared<wamp_event_impl>(std::move(message.zone()));
-
-        event->set_details(message.field(3));
-
         if (message.size() > 4) {
             if (!message.is_field_type(4, msgpack::type::ARRAY)) {
                 throw protocol_error("EVENT - EVENT.Arguments must be a list");
             }
-            event->set_arguments(message.field(4));
 
             if (message.size() > 5) {
                 if (!message.is_field_type(5, msgpack::type::MAP)) {
                     throw protocol_error("EVENT - EVENT.ArgumentsKw must be a dictionary");
                 }
-                event->set_kw_arguments(message.field(5));
             }
         }
 
+        // The details and arguments are only unpacked once the handlers
+        // access them.
+        wamp_event event = std::make_shared<wamp_event_impl>(std::move(message));
+
         try {
             // now trigger the user supplied event handler ..
             //
-            while (subscription_handlers_itr != subscription_handlers_end) {
-                 (subscription_handlers_itr->second)(event);
-                 ++subscription_handlers_itr;
+            for (const auto& handler : *subscription_handlers) {
+                 handler(event);
             }
         } catch (...) {
             if (m_debug_enabled) {
@@ -1321,16 +1909,15 @@ inline void wamp_session::process_registered(wamp_message&& message)
     }
     uint64_t request_id = message.field<uint64_t>(1);
 
-    auto register_request_itr = m_register_requests.find(request_id);
-    if (register_request_itr != m_register_requests.end()) {
+    std::shared_ptr<wamp_register_request> register_request;
+    if (m_register_requests.extract(request_id, register_request)) {
         if (!message.is_field_type(2, msgpack::type::POSITIVE_INTEGER)) {
             throw protocol_error("REGISTERED - REGISTERED.Registration must be an integer");
         }
         uint64_t registration_id = message.field<uint64_t>(2);
 
-        m_procedures[registration_id] = register_request_itr->second->procedure();
-        register_request_itr->second->set_response(wamp_registration(registration_id));
-        m_register_requests.erase(register_request_itr);
+        m_procedures[registration_id] = register_request->procedure();
+        register_request->set_response(wamp_registration(registration_id));
     } else {
         throw protocol_error("REGISTERED - no pending request ID");
     }
@@ -1348,12 +1935,11 @@ inline void wamp_session::process_unregistered(wamp_message&& message)
     }
 
     uint64_t request_id = message.field<uint64_t>(1);
-	auto unregister_request_itr = m_unregister_requests.find(request_id);
-    if (unregister_request_itr != m_unregister_requests.end()) {
-        uint64_t registration_id = unregister_request_itr->second->registration().id();
+    std::shared_ptr<wamp_unregister_request> unregister_request;
+    if (m_unregister_requests.extract(request_id, unregister_request)) {
+        uint64_t registration_id = unregister_request->registration().id();
         m_procedures.erase(registration_id);
-        unregister_request_itr->second->set_response();
-        m_unregister_requests.erase(request_id);
+        unregister_request->set_response();
     } else {
         throw protocol_error("UNREGISTERED - no pending request ID");
     }
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_SLAB_HPP
+#define AUTOBAHN_WAMP_SLAB_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A slab of equally sized memory blocks. Blocks are carved out of larger
+ * chunks and kept on a free list once they are released, so records that
+ * are created and destroyed at a high rate, like the pending calls of a
+ * session, stop allocating once the slab has grown to the peak number of
+ * records.
+ *
+ * The slab takes the block size from its first allocation. Allocations of
+ * any other size are passed on to operator new. Records are allocated by
+ * the threads that start requests and released by the io service that
+ * completes them, so the slab is thread safe.
+ */
+class wamp_slab
+{
+public:
+    /*!
+     * Constructs an empty slab.
+     *
+     * @param blocks_per_chunk The number of blocks allocated at once when
+     *        the free list runs empty.
+     */
+    explicit wamp_slab(std::size_t blocks_per_chunk=64);
+
+    wamp_slab(const wamp_slab&) = delete;
+    wamp_slab& operator=(const wamp_slab&) = delete;
+
+    /*!
+     * Takes a block from the free list.
+     */
+    void* allocate(std::size_t size);
+
+    /*!
+     * Puts a block back on the free list.
+     */
+    void deallocate(void* block, std::size_t size);
+
+private:
+    /*!
+     * A block on the free list.
+     */
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    /*!
+     * Guards the free list and the chunks.
+     */
+    std::mutex m_mutex;
+
+    /*!
+     * The size of the blocks, or zero before the first allocation.
+     */
+    std::size_t m_block_size;
+
+    std::size_t m_blocks_per_chunk;
+
+    /*!
+     * The blocks that are ready to be reused.
+     */
+    free_block* m_free_blocks;
+
+    /*!
+     * The chunks the blocks have been carved from, which are released
+     * along with the slab.
+     */
+    std::vector<std::unique_ptr<char[]>> m_chunks;
+};
+
+/*!
+ * A standard allocator that takes its memory from a wamp_slab, for use with
+ * std::allocate_shared. The allocator shares ownership of the slab, so
+ * records may outlive the object that owns the slab.
+ */
+template <typename T>
+class wamp_slab_allocator
+{
+public:
+    using value_type = T;
+
+    explicit wamp_slab_allocator(const std::shared_ptr<wamp_slab>& slab);
+
+    template <typename U>
+    wamp_slab_allocator(const wamp_slab_allocator<U>& other);
+
+    T* allocate(std::size_t n);
+    void deallocate(T* p, std::size_t n);
+
+    const std::shared_ptr<wamp_slab>& slab() const;
+
+private:
+    std::shared_ptr<wamp_slab> m_slab;
+};
+
+template <typename T, typename U>
+bool operator==(const wamp_slab_allocator<T>& lhs, const wamp_slab_allocator<U>& rhs);
+
+template <typename T, typename U>
+bool operator!=(const wamp_slab_allocator<T>& lhs, const wamp_slab_allocator<U>& rhs);
+
+} // namespace autobahn
+
+#include "wamp_slab.ipp"
+
+#endif // AUTOBAHN_WAMP_SLAB_HPP
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace autobahn {
+
+inline wamp_slab::wamp_slab(std::size_t blocks_per_chunk)
+    : m_mutex()
+    , m_block_size(0)
+    , m_blocks_per_chunk(blocks_per_chunk)
+    , m_free_blocks(nullptr)
+    , m_chunks()
+{
+}
+
+inline void* wamp_slab::allocate(std::size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_block_size == 0) {
+            // Round up so that every block is suitably aligned.
+            const std::size_t alignment = alignof(std::max_align_t);
+            m_block_size = (std::max(size, sizeof(free_block)) + alignment - 1) / alignment * alignment;
+        }
+
+        if (size <= m_block_size) {
+            if (!m_free_blocks) {
+                std::unique_ptr<char[]> chunk(new char[m_block_size * m_blocks_per_chunk]);
+                for (std::size_t i = 0; i < m_blocks_per_chunk; ++i) {
+                    free_block* block = reinterpret_cast<free_block*>(chunk.get() + i * m_block_size);
+                    block->next = m_free_blocks;
+                    m_free_blocks = block;
+                }
+                m_chunks.push_back(std::move(chunk));
+            }
+
+            free_block* block = m_free_blocks;
+            m_free_blocks = block->next;
+            return block;
+        }
+    }
+
+    return ::operator new(size);
+}
+
+inline void wamp_slab::deallocate(void* block, std::size_t size)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (size <= m_block_size) {
+            free_block* freed = static_cast<free_block*>(block);
+            freed->next = m_free_blocks;
+            m_free_blocks = freed;
+            return;
+        }
+    }
+
+    ::operator delete(block);
+}
+
+template <typename T>
+inline wamp_slab_allocator<T>::wamp_slab_allocator(const std::shared_ptr<wamp_slab>& slab)
+    : m_slab(slab)
+{
+}
+
+template <typename T>
+template <typename U>
+inline wamp_slab_allocator<T>::wamp_slab_allocator(const wamp_slab_allocator<U>& other)
+    : m_slab(other.slab())
+{
+}
+
+template <typename T>
+inline T* wamp_slab_allocator<T>::allocate(std::size_t n)
+{
+    return static_cast<T*>(m_slab->allocate(n * sizeof(T)));
+}
+
+template <typename T>
+inline void wamp_slab_allocator<T>::deallocate(T* p, std::size_t n)
+{
+    m_slab->deallocate(p, n * sizeof(T));
+}
+
+template <typename T>
+inline const std::shared_ptr<wamp_slab>& wamp_slab_allocator<T>::slab() const
+{
+    return m_slab;
+}
+
+template <typename T, typename U>
+inline bool operator==(const wamp_slab_allocator<T>& lhs, const wamp_slab_allocator<U>& rhs)
+{
+    return lhs.slab() == rhs.slab();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const wamp_slab_allocator<T>& lhs, const wamp_slab_allocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} // namespace autobahn
@@ -32,6 +32,7 @@
 #define AUTOBAHN_WAMP_SUBSCRIBE_OPTIONS_HPP
 
 #include <boost/optional.hpp>
+#include <string>
 
 namespace autobahn {
 
@@ -52,8 +53,17 @@ public:
     void set_match(const std::string& match);
     bool is_match_set() const;
 
+    /*!
+     * The options packed as a msgpack map. The packed options are kept
+     * up to date by the setters so that messages can copy them as they are.
+     */
+    const std::string& packed() const;
+
 private:
+    void update_packed();
+
     boost::optional<std::string> m_match;
+    std::string m_packed;
 };
 
 } // namespace autobahn
@@ -36,11 +36,13 @@ namespace autobahn {
 
 inline wamp_subscribe_options::wamp_subscribe_options()
     : m_match()
+    , m_packed("\x80", 1) // empty map
 {
 }
 
 inline wamp_subscribe_options::wamp_subscribe_options(const std::string& match)
     : m_match()
+    , m_packed("\x80", 1) // empty map
 {
     //Verify match type
     set_match(match);
@@ -63,6 +65,12 @@ inline void wamp_subscribe_options::set_match(const std::string& match)
         throw std::runtime_error("The value of 'match' must be 'exact', 'prefix', or 'wildcard'.");
     }
     m_match = match;
+    update_packed();
+}
+
+inline const std::string& wamp_subscribe_options::packed() const
+{
+    return m_packed;
 }
 
 } // namespace autobahn
@@ -90,14 +98,15 @@ struct pack<autobahn::wamp_subscribe_options>
             msgpack::packer<Stream>& packer,
             autobahn::wamp_subscribe_options const& options) const
     {
-        std::map<std::string, std::string> options_map;
-
-        if (options.is_match_set())
-        {
-            options_map["match"] = options.match();
+        if (!options.is_match_set()) {
+            packer.pack_map(0);
+            return packer;
         }
 
-        packer.pack(options_map);
+        packer.pack_map(1);
+        packer.pack_str(5);
+        packer.pack_str_body("match", 5);
+        packer.pack(options.match());
 
         return packer;
     }
@@ -125,3 +134,13 @@ struct object_with_zone<autobahn::wamp_subscribe_options>
 } // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
 } // namespace msgpack
 
+namespace autobahn {
+
+inline void wamp_subscribe_options::update_packed()
+{
+    msgpack::sbuffer buffer(16);
+    msgpack::pack(buffer, *this);
+    m_packed.assign(buffer.data(), buffer.size());
+}
+
+} // namespace autobahn
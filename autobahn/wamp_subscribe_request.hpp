@@ -35,23 +35,41 @@
 #include "wamp_subscription.hpp"
 #include "boost_config.hpp"
 
+#include <boost/exception_ptr.hpp>
+
 namespace autobahn {
 
-/// An outstanding wamp call.
+/// An outstanding wamp subscribe request.
 class wamp_subscribe_request
 {
 public:
-    wamp_subscribe_request();
-    wamp_subscribe_request(const wamp_event_handler& handler);
+    explicit wamp_subscribe_request(const wamp_event_handler& handler);
+    virtual ~wamp_subscribe_request();
 
     const wamp_event_handler& handler() const;
-    boost::promise<wamp_subscription>& response();
-    void set_handler(const wamp_event_handler& handler) const;
-    void set_response(const wamp_subscription& subscription);
+
+    virtual void set_response(const wamp_subscription& subscription) = 0;
+    virtual void set_exception(const boost::exception_ptr& exception) = 0;
 
 private:
     wamp_event_handler m_handler;
-    boost::promise<wamp_subscription> m_response;
+};
+
+/// An outstanding wamp subscribe request that reports its response through a
+/// completion, either a wamp_promise_completion or a wamp_handler_completion.
+template <typename Completion>
+class wamp_basic_subscribe_request : public wamp_subscribe_request
+{
+public:
+    wamp_basic_subscribe_request(const wamp_event_handler& handler, Completion&& completion);
+
+    Completion& completion();
+
+    virtual void set_response(const wamp_subscription& subscription) override;
+    virtual void set_exception(const boost::exception_ptr& exception) override;
+
+private:
+    Completion m_completion;
 };
 
 } // namespace autobahn
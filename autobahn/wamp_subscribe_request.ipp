@@ -30,15 +30,12 @@
 
 namespace autobahn {
 
-inline wamp_subscribe_request::wamp_subscribe_request()
-    : m_handler()
-    , m_response()
+inline wamp_subscribe_request::wamp_subscribe_request(const wamp_event_handler& handler)
+    : m_handler(handler)
 {
 }
 
-inline wamp_subscribe_request::wamp_subscribe_request(const wamp_event_handler& handler)
-    : m_handler(handler)
-    , m_response()
+inline wamp_subscribe_request::~wamp_subscribe_request()
 {
 }
 
@@ -47,14 +44,30 @@ inline const wamp_event_handler& wamp_subscribe_request::handler() const
     return m_handler;
 }
 
-inline boost::promise<wamp_subscription>& wamp_subscribe_request::response()
+template <typename Completion>
+inline wamp_basic_subscribe_request<Completion>::wamp_basic_subscribe_request(
+        const wamp_event_handler& handler, Completion&& completion)
+    : wamp_subscribe_request(handler)
+    , m_completion(std::move(completion))
+{
+}
+
+template <typename Completion>
+inline Completion& wamp_basic_subscribe_request<Completion>::completion()
+{
+    return m_completion;
+}
+
+template <typename Completion>
+inline void wamp_basic_subscribe_request<Completion>::set_response(const wamp_subscription& subscription)
 {
-    return m_response;
+    m_completion.set_value(wamp_subscription(subscription));
 }
 
-inline void wamp_subscribe_request::set_response(const wamp_subscription& subscription)
+template <typename Completion>
+inline void wamp_basic_subscribe_request<Completion>::set_exception(const boost::exception_ptr& exception)
 {
-    m_response.set_value(subscription);
+    m_completion.set_exception(exception);
 }
 
 } // namespace autobahn
@@ -49,7 +49,8 @@ public:
     wamp_tcp_transport(
             boost::asio::io_service& io_service,
             const boost::asio::ip::tcp::endpoint& remote_endpoint,
-            bool debug_enabled=false);
+            bool debug_enabled=false,
+            const wamp_rawsocket_options& options=wamp_rawsocket_options());
     virtual ~wamp_tcp_transport() override;
 
     virtual boost::future<void> connect() override;
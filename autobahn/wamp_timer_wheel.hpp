@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_TIMER_WHEEL_HPP
+#define AUTOBAHN_WAMP_TIMER_WHEEL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A hashed timing wheel that tracks deadlines for request ids with a fixed
+ * resolution. Each deadline is a node that the caller embeds in its own
+ * record, so scheduling and cancelling a deadline are O(1) and allocate
+ * nothing, no matter how many deadlines are outstanding. Advancing the
+ * wheel by one tick only visits the nodes hashed to that tick's slot.
+ *
+ * The wheel is not thread safe. The session only uses it on its io service.
+ */
+class wamp_timer_wheel
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /*!
+     * A deadline in the wheel. A node that is destroyed while scheduled
+     * removes itself from the wheel.
+     */
+    class node
+    {
+    public:
+        node();
+        ~node();
+
+        node(const node&) = delete;
+        node& operator=(const node&) = delete;
+
+        /*!
+         * Whether or not the node is scheduled in a wheel.
+         */
+        bool scheduled() const;
+
+    private:
+        friend class wamp_timer_wheel;
+
+        wamp_timer_wheel* m_wheel;
+        node* m_previous;
+        node* m_next;
+        uint64_t m_id;
+        uint64_t m_expiry_tick;
+    };
+
+    /*!
+     * Constructs an empty wheel.
+     *
+     * @param resolution The duration of a tick. Deadlines expire on the
+     *        first tick at or after them.
+     * @param num_slots The number of slots, rounded up to a power of two.
+     *        Deadlines further out than one turn of the wheel stay in
+     *        their slot for several turns.
+     */
+    explicit wamp_timer_wheel(
+            std::chrono::milliseconds resolution=std::chrono::milliseconds(10),
+            std::size_t num_slots=1024);
+
+    ~wamp_timer_wheel();
+
+    wamp_timer_wheel(const wamp_timer_wheel&) = delete;
+    wamp_timer_wheel& operator=(const wamp_timer_wheel&) = delete;
+
+    /*!
+     * Schedules the node to expire the given id at the deadline. A node
+     * that is already scheduled is rescheduled.
+     */
+    void schedule(node& n, uint64_t id, clock::time_point deadline);
+
+    /*!
+     * Removes the node from the wheel if it is scheduled.
+     */
+    void cancel(node& n);
+
+    /*!
+     * Advances the wheel to the given time and calls the function with the
+     * id of each node that has expired. The nodes have been removed from the
+     * wheel by the time the function is called, so it may reschedule them.
+     */
+    template <typename Function>
+    void advance(clock::time_point now, Function&& expired);
+
+    /*!
+     * The time of the next tick, for arming a timer.
+     */
+    clock::time_point next_tick() const;
+
+    /*!
+     * The number of scheduled nodes.
+     */
+    std::size_t size() const;
+
+    bool empty() const;
+
+private:
+    uint64_t expiry_tick(clock::time_point deadline) const;
+    void unlink(node& n);
+
+    clock::time_point m_start;
+    clock::duration m_resolution;
+
+    /*!
+     * The last tick that the wheel has been advanced to.
+     */
+    uint64_t m_current_tick;
+
+    /*!
+     * The heads of the slot lists, indexed by the expiry tick modulo the
+     * number of slots.
+     */
+    std::vector<node*> m_slots;
+    std::size_t m_size;
+
+    /*!
+     * The ids expired by the current advance, kept to reuse its storage.
+     */
+    std::vector<uint64_t> m_expired;
+};
+
+} // namespace autobahn
+
+#include "wamp_timer_wheel.ipp"
+
+#endif // AUTOBAHN_WAMP_TIMER_WHEEL_HPP
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <utility>
+
+namespace autobahn {
+
+inline wamp_timer_wheel::node::node()
+    : m_wheel(nullptr)
+    , m_previous(nullptr)
+    , m_next(nullptr)
+    , m_id(0)
+    , m_expiry_tick(0)
+{
+}
+
+inline wamp_timer_wheel::node::~node()
+{
+    if (m_wheel) {
+        m_wheel->cancel(*this);
+    }
+}
+
+inline bool wamp_timer_wheel::node::scheduled() const
+{
+    return m_wheel != nullptr;
+}
+
+inline wamp_timer_wheel::wamp_timer_wheel(std::chrono::milliseconds resolution, std::size_t num_slots)
+    : m_start(clock::now())
+    , m_resolution(std::max<clock::duration>(resolution, clock::duration(1)))
+    , m_current_tick(0)
+    , m_slots()
+    , m_size(0)
+    , m_expired()
+{
+    std::size_t slots = 1;
+    while (slots < num_slots) {
+        slots <<= 1;
+    }
+    m_slots.assign(slots, nullptr);
+}
+
+inline wamp_timer_wheel::~wamp_timer_wheel()
+{
+    for (node* head : m_slots) {
+        while (head) {
+            node* next = head->m_next;
+            head->m_wheel = nullptr;
+            head->m_previous = nullptr;
+            head->m_next = nullptr;
+            head = next;
+        }
+    }
+}
+
+inline void wamp_timer_wheel::schedule(node& n, uint64_t id, clock::time_point deadline)
+{
+    cancel(n);
+
+    // A deadline that has passed already expires on the next tick.
+    n.m_id = id;
+    n.m_expiry_tick = std::max(expiry_tick(deadline), m_current_tick + 1);
+
+    node*& head = m_slots[n.m_expiry_tick & (m_slots.size() - 1)];
+    n.m_wheel = this;
+    n.m_previous = nullptr;
+    n.m_next = head;
+    if (head) {
+        head->m_previous = &n;
+    }
+    head = &n;
+    ++m_size;
+}
+
+inline void wamp_timer_wheel::cancel(node& n)
+{
+    if (n.m_wheel == this) {
+        unlink(n);
+    }
+}
+
+template <typename Function>
+inline void wamp_timer_wheel::advance(clock::time_point now, Function&& expired)
+{
+    // The ticks that have passed by now.
+    const uint64_t target_tick = now > m_start
+            ? static_cast<uint64_t>((now - m_start) / m_resolution) : 0;
+    if (target_tick <= m_current_tick) {
+        return;
+    }
+
+    // Every slot is visited once at most, even if the wheel has fallen
+    // behind by more than a turn.
+    const uint64_t ticks = std::min<uint64_t>(target_tick - m_current_tick, m_slots.size());
+    m_expired.clear();
+    for (uint64_t tick = m_current_tick + 1; tick <= m_current_tick + ticks; ++tick) {
+        node* n = m_slots[tick & (m_slots.size() - 1)];
+        while (n) {
+            node* next = n->m_next;
+            if (n->m_expiry_tick <= target_tick) {
+                m_expired.push_back(n->m_id);
+                unlink(*n);
+            }
+            n = next;
+        }
+    }
+    m_current_tick = target_tick;
+
+    for (uint64_t id : m_expired) {
+        expired(id);
+    }
+}
+
+inline wamp_timer_wheel::clock::time_point wamp_timer_wheel::next_tick() const
+{
+    return m_start + m_resolution * static_cast<clock::rep>(m_current_tick + 1);
+}
+
+inline std::size_t wamp_timer_wheel::size() const
+{
+    return m_size;
+}
+
+inline bool wamp_timer_wheel::empty() const
+{
+    return m_size == 0;
+}
+
+inline uint64_t wamp_timer_wheel::expiry_tick(clock::time_point deadline) const
+{
+    if (deadline <= m_start) {
+        return 0;
+    }
+
+    // Round up, so that a deadline never expires early.
+    return static_cast<uint64_t>((deadline - m_start + m_resolution - clock::duration(1)) / m_resolution);
+}
+
+inline void wamp_timer_wheel::unlink(node& n)
+{
+    if (n.m_previous) {
+        n.m_previous->m_next = n.m_next;
+    } else {
+        m_slots[n.m_expiry_tick & (m_slots.size() - 1)] = n.m_next;
+    }
+    if (n.m_next) {
+        n.m_next->m_previous = n.m_previous;
+    }
+    n.m_wheel = nullptr;
+    n.m_previous = nullptr;
+    n.m_next = nullptr;
+    --m_size;
+}
+
+} // namespace autobahn
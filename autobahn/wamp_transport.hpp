@@ -33,6 +33,7 @@
 
 #include "boost_config.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -41,6 +42,13 @@ namespace autobahn {
 class wamp_message;
 class wamp_transport_handler;
 
+/*!
+ * The default watermarks for the octets that a transport buffers for
+ * sending, shared by the rawsocket and the websocket transports.
+ */
+static const std::size_t DEFAULT_SEND_HIGH_WATERMARK = 4 * 1024 * 1024;
+static const std::size_t DEFAULT_SEND_LOW_WATERMARK = 1024 * 1024;
+
 /*!
  * Provides an abstraction for a transport to be used by the session. A wamp
  * transport is defined as being message based, bidirectional, reliable, and
@@ -95,7 +103,10 @@ public:
      * SENDER INTERFACE
      */
     /*!
-     * Send the message synchronously over the transport.
+     * Send the message over the transport. The message is serialized right
+     * away, but may be queued and written asynchronously, together with
+     * other messages. A failure to write is not reported to the caller but
+     * closes the connection and detaches the handler.
      *
      * @param message The message to be sent.
      */
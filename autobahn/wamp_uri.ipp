@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_uri::wamp_uri(const std::string& uri)
+    : m_uri(uri)
+    , m_packed()
+{
+    msgpack::sbuffer buffer(uri.size() + 5);
+    msgpack::packer<msgpack::sbuffer> packer(buffer);
+    packer.pack(m_uri);
+
+    m_packed.assign(buffer.data(), buffer.size());
+}
+
+inline const std::string& wamp_uri::str() const
+{
+    return m_uri;
+}
+
+inline const std::string& wamp_uri::packed() const
+{
+    return m_packed;
+}
+
+} // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template<>
+struct pack<autobahn::wamp_uri>
+{
+    template <typename Stream>
+    msgpack::packer<Stream>& operator()(
+            msgpack::packer<Stream>& packer,
+            autobahn::wamp_uri const& uri) const
+    {
+        packer.pack(uri.str());
+        return packer;
+    }
+};
+
+template <>
+struct object_with_zone<autobahn::wamp_uri>
+{
+    void operator()(
+            msgpack::object::with_zone& object,
+            const autobahn::wamp_uri& uri) const
+    {
+        object << uri.str();
+    }
+};
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
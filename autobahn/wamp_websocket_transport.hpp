@@ -32,12 +32,16 @@
 #define AUTOBAHN_WEBSOCKET_TRANSPORT_HPP
 
 #include "boost_config.hpp"
+#include "wamp_buffer_pool.hpp"
+#include "wamp_serializer.hpp"
 #include "wamp_transport.hpp"
 
 #include <boost/asio/io_service.hpp>
 #include <cstddef>
 #include <memory>
 #include <msgpack.hpp>
+#include <string>
+#include <vector>
 
 namespace autobahn {
 
@@ -135,6 +139,31 @@ namespace autobahn {
         */
         virtual bool has_handler() const override;
 
+        /*!
+        * Sets the watermarks for the octets buffered for sending. Reaching the
+        * high watermark invokes the pause handler, draining down to the low
+        * watermark invokes the resume handler. A high watermark of zero
+        * disables this. Throws an std::invalid_argument if the low watermark
+        * exceeds a non zero high watermark. Defaults to 4 MiB and 1 MiB.
+        */
+        void set_send_watermarks(std::size_t high_watermark, std::size_t low_watermark);
+
+        /*!
+        * Sets the serializers to offer to the peer as websocket subprotocols,
+        * in order of preference. Has to be called before connecting. Throws
+        * an exception if no serializer is given.
+        */
+        void set_serializers(std::vector<std::shared_ptr<wamp_serializer>> serializers);
+
+        /*!
+        * Sets whether or not received msgpack EVENT, RESULT and INVOCATION
+        * messages are decoded lazily, as the rawsocket option of the same
+        * name does. A lazily decoded message is copied out of the websocket
+        * frame and keeps its packed arguments, so that they can be passed on
+        * as a raw payload. All other messages are unpacked right away. Off
+        * by default.
+        */
+        void set_lazy_decoding(bool lazy_decoding);
 
     protected:
         virtual bool is_open() const = 0;
@@ -143,10 +172,69 @@ namespace autobahn {
         virtual void async_connect(const std::string& m_uri, boost::promise<void>& connect_promise) = 0;
         virtual void close() = 0;
 
+        /*!
+        * Sends a serialized message. The payload is only valid for the
+        * duration of the call, implementations have to copy it if they
+        * send it asynchronously.
+        */
         virtual void write(void const * payload, size_t len) = 0;
 
         void receive_message(const std::string& msg);
 
+        /*!
+        * Closes the connection after receiving a message that cannot be
+        * decoded, and detaches the handler.
+        */
+        void fail_connection(const std::string& reason);
+
+        /*!
+        * The number of octets that have been handed to write() but have not
+        * been written to the network yet. Implementations that cannot tell
+        * report zero, which disables the send watermarks.
+        */
+        virtual std::size_t buffered_amount() const;
+
+        /*!
+        * Stops reading from the underlying connection.
+        */
+        virtual void pause_reading();
+
+        /*!
+        * Starts reading from the underlying connection again.
+        */
+        virtual void resume_reading();
+
+        /*!
+        * Arranges for check_send_watermarks() to be called again later. This
+        * is used while sending is paused since there is no notification when
+        * buffered data has been written.
+        */
+        virtual void schedule_send_watermarks_check();
+
+        /*!
+        * Compares the buffered amount against the send watermarks and
+        * invokes the pause or resume handler when one has been crossed.
+        */
+        void check_send_watermarks();
+
+        /*!
+        * The serializers to offer to the peer, in order of preference.
+        */
+        const std::vector<std::shared_ptr<wamp_serializer>>& serializers() const;
+
+        /*!
+        * The serializer used for the current connection.
+        */
+        const std::shared_ptr<wamp_serializer>& serializer() const;
+
+        /*!
+        * Selects the serializer for the subprotocol that the peer agreed to.
+        * An empty subprotocol selects the most preferred serializer.
+        *
+        * @return Whether or not a serializer for the subprotocol is configured.
+        */
+        bool select_serializer(const std::string& subprotocol);
+
         /*!
         * The promise that is fulfilled when the connect attempt is complete.
         */
@@ -179,15 +267,48 @@ namespace autobahn {
             std::shared_ptr<wamp_transport_handler> m_handler;
 
             /*!
-            * Used for unpacking serialized messages.
+            * Buffers reused for serializing outgoing messages. This only
+            * saves the serialization buffer: write() implementations such
+            * as websocketpp's send() still allocate a message of their own
+            * and copy the payload into it, once per message.
+            */
+            wamp_buffer_pool m_send_buffers;
+
+            /*!
+            * The serializers to offer to the peer.
+            */
+            std::vector<std::shared_ptr<wamp_serializer>> m_serializers;
+
+            /*!
+            * The serializer used for the current connection.
+            */
+            std::shared_ptr<wamp_serializer> m_serializer;
+
+            /*!
+            * The buffered amount at which sending is paused.
+            */
+            std::size_t m_high_watermark;
+
+            /*!
+            * The buffered amount at which sending is resumed.
             */
-            msgpack::unpacker m_message_unpacker;
+            std::size_t m_low_watermark;
+
+            /*!
+            * Whether or not the pause handler has been invoked.
+            */
+            bool m_send_paused;
+
+            /*!
+            * Whether or not messages that carry payloads are decoded lazily.
+            */
+            bool m_lazy_decoding;
 
             /*!
             * Whether or not debugging is enabled.
             */
             bool m_debug_enabled;
-            
+
             /*!
             * Websocket endpoint URI
             */
@@ -30,12 +30,15 @@
 
 #include "exceptions.hpp"
 #include "wamp_message.hpp"
+#include "wamp_serializers.hpp"
 #include "wamp_transport_handler.hpp"
 
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/placeholders.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
+#include <boost/optional.hpp>
+#include <stdexcept>
 #include <system_error>
 
 namespace autobahn {
@@ -46,7 +49,13 @@ inline wamp_websocket_transport::wamp_websocket_transport(
     : wamp_transport()
     , m_connect()
     , m_disconnect()
-    , m_message_unpacker()
+    , m_send_buffers()
+    , m_serializers({ make_wamp_serializer(wamp_rawsocket_serializer::msgpack) })
+    , m_serializer(m_serializers.front())
+    , m_high_watermark(DEFAULT_SEND_HIGH_WATERMARK)
+    , m_low_watermark(DEFAULT_SEND_LOW_WATERMARK)
+    , m_send_paused(false)
+    , m_lazy_decoding(false)
     , m_debug_enabled(debug_enabled)
     , m_uri(uri)
 {
@@ -83,10 +92,8 @@ inline bool wamp_websocket_transport::is_connected() const
 
 inline void wamp_websocket_transport::send_message(wamp_message&& message)
 {
-    auto buffer = std::make_shared<msgpack::sbuffer>();
-    msgpack::packer<msgpack::sbuffer> packer(*buffer);
-    packer.pack(message.fields());
-
+    auto buffer = m_send_buffers.acquire();
+    m_serializer->serialize(message, *buffer);
 
     // Write actual serialized message.
     write(buffer->data(), buffer->size());
@@ -95,6 +102,15 @@ inline void wamp_websocket_transport::send_message(wamp_message&& message)
         std::cerr << "TX message (" << buffer->size() << " octets) ..." << std::endl;
         std::cerr << "TX message: " << message << std::endl;
     }
+
+    // write() has copied the payload, so the buffer can be reused right away.
+    // The copy is not avoided, websocketpp allocates a message for it.
+    m_send_buffers.release(std::move(buffer));
+
+    // While paused the scheduled watermark checks take care of resuming.
+    if (!m_send_paused) {
+        check_send_watermarks();
+    }
 }
 
 inline void wamp_websocket_transport::set_pause_handler(pause_handler&& handler)
@@ -109,16 +125,12 @@ inline void wamp_websocket_transport::set_resume_handler(resume_handler&& handle
 
 inline void wamp_websocket_transport::pause()
 {
-    if (m_pause_handler) {
-        m_pause_handler();
-    }
+    pause_reading();
 }
 
 inline void wamp_websocket_transport::resume()
 {
-    if (m_resume_handler) {
-        m_resume_handler();
-    }
+    resume_reading();
 }
 
 inline void wamp_websocket_transport::attach(
@@ -148,31 +160,167 @@ inline bool wamp_websocket_transport::has_handler() const
     return m_handler != nullptr;
 }
 
+inline void wamp_websocket_transport::set_send_watermarks(
+    std::size_t high_watermark, std::size_t low_watermark)
+{
+    if (high_watermark != 0 && low_watermark > high_watermark) {
+        throw std::invalid_argument("low watermark must not exceed the high watermark");
+    }
 
-inline void wamp_websocket_transport::receive_message(const std::string& msg)
+    m_high_watermark = high_watermark;
+    m_low_watermark = low_watermark;
+}
+
+inline void wamp_websocket_transport::set_serializers(
+    std::vector<std::shared_ptr<wamp_serializer>> serializers)
 {
-    if (m_debug_enabled) {
-        std::cerr << "RX message received." << std::endl;
+    if (serializers.empty()) {
+        throw std::invalid_argument("at least one serializer is required");
     }
 
-    if (m_handler) {
-        m_message_unpacker.reserve_buffer(msg.size());
-        memcpy(m_message_unpacker.buffer(), msg.data(), msg.size());
-        m_message_unpacker.buffer_consumed(msg.size());
+    m_serializers = std::move(serializers);
+    m_serializer = m_serializers.front();
+}
+
+inline void wamp_websocket_transport::set_lazy_decoding(bool lazy_decoding)
+{
+    m_lazy_decoding = lazy_decoding;
+}
+
+inline const std::vector<std::shared_ptr<wamp_serializer>>& wamp_websocket_transport::serializers() const
+{
+    return m_serializers;
+}
+
+inline const std::shared_ptr<wamp_serializer>& wamp_websocket_transport::serializer() const
+{
+    return m_serializer;
+}
+
+inline bool wamp_websocket_transport::select_serializer(const std::string& subprotocol)
+{
+    if (subprotocol.empty()) {
+        m_serializer = m_serializers.front();
+        return true;
+    }
+
+    for (const auto& serializer : m_serializers) {
+        if (subprotocol == serializer->subprotocol()) {
+            m_serializer = serializer;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline std::size_t wamp_websocket_transport::buffered_amount() const
+{
+    return 0;
+}
+
+inline void wamp_websocket_transport::pause_reading()
+{
+}
 
-        msgpack::unpacked result;
+inline void wamp_websocket_transport::resume_reading()
+{
+}
+
+inline void wamp_websocket_transport::schedule_send_watermarks_check()
+{
+}
 
-        while (m_message_unpacker.next(result)) {
-            wamp_message::message_fields fields;
-            result.get().convert(fields);
+inline void wamp_websocket_transport::check_send_watermarks()
+{
+    if (m_high_watermark == 0) {
+        return;
+    }
 
-            wamp_message message(std::move(fields), std::move(*(result.zone())));
+    const std::size_t buffered = buffered_amount();
+    if (!m_send_paused) {
+        if (buffered >= m_high_watermark) {
             if (m_debug_enabled) {
-                std::cerr << "RX message: " << message << std::endl;
+                std::cerr << "TX buffer reached high watermark (" << buffered
+                    << " octets), pausing" << std::endl;
+            }
+
+            m_send_paused = true;
+            if (m_pause_handler) {
+                m_pause_handler();
+            }
+            schedule_send_watermarks_check();
+        }
+    } else if (buffered <= m_low_watermark) {
+        if (m_debug_enabled) {
+            std::cerr << "TX buffer drained to low watermark (" << buffered
+                << " octets), resuming" << std::endl;
+        }
+
+        m_send_paused = false;
+        if (m_resume_handler) {
+            m_resume_handler();
+        }
+    } else {
+        schedule_send_watermarks_check();
+    }
+}
+
+
+inline void wamp_websocket_transport::fail_connection(const std::string& reason)
+{
+    if (m_debug_enabled) {
+        std::cerr << "RX " << reason << ", closing connection" << std::endl;
+    }
+
+    close();
+
+    // Let the session fail what it is waiting for, as the rawsocket
+    // transport does.
+    if (m_handler) {
+        std::shared_ptr<wamp_transport_handler> handler;
+        m_handler.swap(handler);
+        handler->on_detach(false, reason);
+    }
+}
+
+inline void wamp_websocket_transport::receive_message(const std::string& msg)
+{
+    if (m_debug_enabled) {
+        std::cerr << "RX message received." << std::endl;
+    }
+
+    if (m_handler) {
+        // Only msgpack messages that carry payloads are decoded lazily, as
+        // on the rawsocket transport. Their fields are only unpacked once
+        // they are accessed, locating the fields validates the framing.
+        boost::optional<wamp_message> message;
+        if (m_serializer->rawsocket_id() == wamp_rawsocket_serializer::msgpack
+                && m_lazy_decoding
+                && wamp_message::is_lazily_decoded(msg.data(), msg.size())) {
+            std::unique_ptr<msgpack::sbuffer> encoded(new msgpack::sbuffer(msg.size()));
+            encoded->write(msg.data(), msg.size());
+            message = wamp_message(std::move(encoded));
+            try {
+                message->size();
+            } catch (const msgpack::unpack_error&) {
+                fail_connection("invalid message frame");
+                return;
+            }
+        } else {
+            try {
+                message = m_serializer->deserialize(msg.data(), msg.size());
+            } catch (const protocol_error& e) {
+                fail_connection(e.what());
+                return;
             }
+        }
 
-            m_handler->on_message(std::move(message));
+        if (m_debug_enabled) {
+            std::cerr << "RX message: " << *message << std::endl;
         }
+
+        m_handler->on_message(std::move(*message));
     }
     else {
         std::cerr << "RX message ignored: no handler attached" << std::endl;
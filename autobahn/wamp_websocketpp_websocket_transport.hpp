@@ -79,6 +79,10 @@ namespace autobahn {
         virtual void close() override;
         virtual void async_connect(const std::string& uri, boost::promise<void>& connect_promise) override;
         virtual void write(void const * payload, size_t len) override;
+        virtual std::size_t buffered_amount() const override;
+        virtual void pause_reading() override;
+        virtual void resume_reading() override;
+        virtual void schedule_send_watermarks_check() override;
 
     private:
 
@@ -86,6 +90,7 @@ namespace autobahn {
         void on_ws_close(websocketpp::connection_hdl);
         void on_ws_fail(websocketpp::connection_hdl);
         void on_ws_message(websocketpp::connection_hdl, typename client_type::message_ptr msg);
+        void on_send_watermarks_timer(const websocketpp::lib::error_code& ec);
     private:
         /*!
         * The underlying socket for the transport.
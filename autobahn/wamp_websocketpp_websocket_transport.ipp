@@ -79,11 +79,21 @@ namespace autobahn {
 
     // The open handler will signal that we are ready to start sending telemetry
     template <class Config>
-    inline void wamp_websocketpp_websocket_transport<Config>::on_ws_open(websocketpp::connection_hdl) {
+    inline void wamp_websocketpp_websocket_transport<Config>::on_ws_open(websocketpp::connection_hdl hdl) {
         scoped_lock guard(m_lock);
         m_open = true;
 
         //No handshake for websockets beyond declaring sub-protocol
+        typename client_type::connection_ptr con = m_client.get_con_from_hdl(hdl);
+        if (!select_serializer(con->get_subprotocol())) {
+            m_connect.set_exception(boost::copy_exception(protocol_error(
+                "peer selected an unsupported subprotocol: " + con->get_subprotocol())));
+
+            websocketpp::lib::error_code ec;
+            m_client.close(hdl, websocketpp::close::status::protocol_error, "unsupported subprotocol", ec);
+            return;
+        }
+
         m_connect.set_value();
 
     }
@@ -108,12 +118,10 @@ namespace autobahn {
 
     template <class Config>
     inline void wamp_websocketpp_websocket_transport<Config>::on_ws_message(websocketpp::connection_hdl, typename client_type::message_ptr msg) {
-        if (msg->get_opcode() == websocketpp::frame::opcode::binary) {
+        if (msg->get_opcode() == websocketpp::frame::opcode::binary
+            || msg->get_opcode() == websocketpp::frame::opcode::text) {
             receive_message(msg->get_payload());
         }
-        else {
-            //m_messages.push_back("<< " + websocketpp::utility::to_hex(msg->get_payload()));
-        }
     }
 
     template <class Config>
@@ -127,8 +135,9 @@ namespace autobahn {
             return;
         }
 
-        //TODO: need to abstract encoding and get subprotocol
-        con->add_subprotocol("wamp.2.msgpack");
+        for (const auto& serializer : serializers()) {
+            con->add_subprotocol(serializer->subprotocol());
+        }
 
         // Grab a handle for this connection so we can talk to it in a thread
         // safe manor after the event loop starts.
@@ -141,9 +150,71 @@ namespace autobahn {
 
     template <class Config>
     inline void wamp_websocketpp_websocket_transport<Config>::write(void const * payload, size_t len)
+    {
+        // send() allocates a message from the connection's message manager
+        // and copies the payload into it, there is no way to hand it a
+        // buffer to send from.
+        websocketpp::lib::error_code ec;
+        m_client.send(m_hdl, payload, len,
+            serializer()->is_binary() ? websocketpp::frame::opcode::binary : websocketpp::frame::opcode::text, ec);
+    }
+
+    template <class Config>
+    inline std::size_t wamp_websocketpp_websocket_transport<Config>::buffered_amount() const
+    {
+        websocketpp::lib::error_code ec;
+        typename client_type::connection_ptr con = m_client.get_con_from_hdl(m_hdl, ec);
+        if (ec) {
+            return 0;
+        }
+
+        return con->get_buffered_amount();
+    }
+
+    template <class Config>
+    inline void wamp_websocketpp_websocket_transport<Config>::pause_reading()
     {
         websocketpp::lib::error_code ec;
-        m_client.send(m_hdl, payload, len, websocketpp::frame::opcode::binary, ec);
+        typename client_type::connection_ptr con = m_client.get_con_from_hdl(m_hdl, ec);
+        if (!ec) {
+            con->pause_reading();
+        }
+    }
+
+    template <class Config>
+    inline void wamp_websocketpp_websocket_transport<Config>::resume_reading()
+    {
+        websocketpp::lib::error_code ec;
+        typename client_type::connection_ptr con = m_client.get_con_from_hdl(m_hdl, ec);
+        if (!ec) {
+            con->resume_reading();
+        }
+    }
+
+    template <class Config>
+    inline void wamp_websocketpp_websocket_transport<Config>::schedule_send_watermarks_check()
+    {
+        // WebSocket++ has no notification for drained send buffers, so poll.
+        // The timer may fire after the transport has gone away.
+        std::weak_ptr<wamp_websocket_transport> weak_self = this->shared_from_this();
+        m_client.set_timer(10, [this, weak_self](const websocketpp::lib::error_code& ec) {
+            auto shared_self = weak_self.lock();
+            if (!shared_self) {
+                return;
+            }
+
+            on_send_watermarks_timer(ec);
+        });
+    }
+
+    template <class Config>
+    inline void wamp_websocketpp_websocket_transport<Config>::on_send_watermarks_timer(const websocketpp::lib::error_code& ec)
+    {
+        if (ec || m_done) {
+            return;
+        }
+
+        check_send_watermarks();
     }
 
     template <class Config>
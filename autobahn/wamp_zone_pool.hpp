@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_ZONE_POOL_HPP
+#define AUTOBAHN_WAMP_ZONE_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <msgpack/sbuffer.hpp>
+#include <msgpack/zone.hpp>
+#include <mutex>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A free list of msgpack zones. Every zone allocates its first chunk
+ * when it is constructed, so reusing cleared zones avoids a malloc/free
+ * pair for each short-lived message. A cleared zone keeps its first
+ * chunk and frees any additional chunks, so a pooled zone holds at
+ * most one chunk.
+ *
+ * The pool also keeps the buffers that encode_wamp_message() packs
+ * outgoing messages into, so that an encoded message allocates neither
+ * its buffer nor its zone in steady state.
+ *
+ * Zones are acquired by the threads that build messages and released
+ * by the io service that sends them, so the pool is thread safe.
+ */
+class wamp_zone_pool
+{
+public:
+    /*!
+     * Constructs a zone pool.
+     *
+     * @param max_zones The maximum number of zones held by the pool,
+     *        and also the maximum number of buffers.
+     * @param max_buffer_size Buffers that held more than this many octets
+     *        are released instead of being pooled.
+     */
+    explicit wamp_zone_pool(std::size_t max_zones=64, std::size_t max_buffer_size=64 * 1024);
+
+    /*!
+     * Takes a cleared zone from the pool, or constructs a new one if the
+     * pool is empty.
+     */
+    msgpack::zone acquire();
+
+    /*!
+     * Clears a zone and hands it back to the pool. The zone is destroyed
+     * if the pool is full.
+     */
+    void release(msgpack::zone&& zone);
+
+    /*!
+     * Takes an empty buffer from the pool, or allocates a new one if the
+     * pool is empty.
+     */
+    std::unique_ptr<msgpack::sbuffer> acquire_buffer();
+
+    /*!
+     * Clears a buffer and hands it back to the pool. The buffer is
+     * destroyed if it is too large or if the pool is full.
+     */
+    void release_buffer(std::unique_ptr<msgpack::sbuffer>&& buffer);
+
+private:
+    /*!
+     * Guards the free list.
+     */
+    std::mutex m_mutex;
+
+    /*!
+     * The zones that are ready to be reused.
+     */
+    std::vector<msgpack::zone> m_free_zones;
+
+    /*!
+     * The buffers that are ready to be reused.
+     */
+    std::vector<std::unique_ptr<msgpack::sbuffer>> m_free_buffers;
+
+    /*!
+     * The maximum number of zones held by the pool.
+     */
+    std::size_t m_max_zones;
+
+    /*!
+     * The maximum size of a buffer that is still pooled.
+     */
+    std::size_t m_max_buffer_size;
+};
+
+} // namespace autobahn
+
+#include "wamp_zone_pool.ipp"
+
+#endif // AUTOBAHN_WAMP_ZONE_POOL_HPP
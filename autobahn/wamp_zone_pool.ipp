@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_zone_pool::wamp_zone_pool(std::size_t max_zones, std::size_t max_buffer_size)
+    : m_mutex()
+    , m_free_zones()
+    , m_free_buffers()
+    , m_max_zones(max_zones)
+    , m_max_buffer_size(max_buffer_size)
+{
+    m_free_zones.reserve(max_zones);
+    m_free_buffers.reserve(max_zones);
+}
+
+inline msgpack::zone wamp_zone_pool::acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_free_zones.empty()) {
+            msgpack::zone zone(std::move(m_free_zones.back()));
+            m_free_zones.pop_back();
+            return zone;
+        }
+    }
+
+    return msgpack::zone();
+}
+
+inline void wamp_zone_pool::release(msgpack::zone&& zone)
+{
+    // Run the finalizers and free the extra chunks outside of the lock.
+    zone.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_free_zones.size() < m_max_zones) {
+        m_free_zones.push_back(std::move(zone));
+    }
+}
+
+inline std::unique_ptr<msgpack::sbuffer> wamp_zone_pool::acquire_buffer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_free_buffers.empty()) {
+            std::unique_ptr<msgpack::sbuffer> buffer(std::move(m_free_buffers.back()));
+            m_free_buffers.pop_back();
+            return buffer;
+        }
+    }
+
+    return std::unique_ptr<msgpack::sbuffer>(new msgpack::sbuffer(256));
+}
+
+inline void wamp_zone_pool::release_buffer(std::unique_ptr<msgpack::sbuffer>&& buffer)
+{
+    if (!buffer || buffer->size() > m_max_buffer_size) {
+        buffer.reset();
+        return;
+    }
+
+    buffer->clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_free_buffers.size() < m_max_zones) {
+        m_free_buffers.push_back(std::move(buffer));
+    }
+}
+
+} // namespace autobahn
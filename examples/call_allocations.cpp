@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Counts the heap allocations made per call in steady state. Run the callee
+// example first, which provides com.examples.calculator.add2, then run this
+// with the same router parameters.
+
+#include "parameters.hpp"
+
+#include <autobahn/autobahn.hpp>
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <tuple>
+
+namespace {
+
+std::atomic<std::size_t> allocations(0);
+
+const std::size_t warmup_calls = 1000;
+const std::size_t measured_calls = 10000;
+
+// Makes each call from the result handler of the previous one, so that
+// there is exactly one call outstanding at any time. The handler only
+// holds a pointer, which keeps the handler itself from allocating.
+struct call_loop
+{
+    boost::asio::io_service* io;
+    std::shared_ptr<autobahn::wamp_session> session;
+    std::string procedure;
+    std::tuple<uint64_t, uint64_t> arguments;
+    autobahn::wamp_call_options options;
+    std::size_t calls;
+    std::size_t measured_allocations;
+    std::chrono::steady_clock::time_point started;
+    std::chrono::steady_clock::time_point finished;
+
+    void call();
+};
+
+struct call_handler
+{
+    call_loop* loop;
+
+    void operator()(boost::system::error_code ec, autobahn::wamp_call_result /*result*/) const
+    {
+        if (ec) {
+            std::cerr << "call failed: " << ec.message() << std::endl;
+            loop->io->stop();
+            return;
+        }
+
+        ++loop->calls;
+        if (loop->calls == warmup_calls) {
+            allocations = 0;
+            loop->started = std::chrono::steady_clock::now();
+        } else if (loop->calls == warmup_calls + measured_calls) {
+            loop->measured_allocations = allocations;
+            loop->finished = std::chrono::steady_clock::now();
+            loop->io->stop();
+            return;
+        }
+
+        loop->call();
+    }
+};
+
+void call_loop::call()
+{
+    session->async_call(procedure, arguments, options, call_handler{this});
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+int main(int argc, char** argv)
+{
+    try {
+        auto parameters = get_parameters(argc, argv);
+
+        boost::asio::io_service io;
+        bool debug = parameters->debug();
+        auto transport = std::make_shared<autobahn::wamp_tcp_transport>(
+                io, parameters->rawsocket_endpoint(), debug);
+
+        auto session = std::make_shared<autobahn::wamp_session>(io, debug);
+
+        transport->attach(std::static_pointer_cast<autobahn::wamp_transport_handler>(session));
+
+        boost::future<void> connect_future;
+        boost::future<void> start_future;
+        boost::future<void> join_future;
+
+        call_loop loop;
+        loop.io = &io;
+        loop.session = session;
+        loop.procedure = "com.examples.calculator.add2";
+        loop.arguments = std::make_tuple(23, 777);
+        loop.calls = 0;
+        loop.measured_allocations = 0;
+
+        connect_future = transport->connect().then([&](boost::future<void> connected) {
+            try {
+                connected.get();
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                io.stop();
+                return;
+            }
+
+            start_future = session->start().then([&](boost::future<void> started) {
+                try {
+                    started.get();
+                } catch (const std::exception& e) {
+                    std::cerr << e.what() << std::endl;
+                    io.stop();
+                    return;
+                }
+
+                join_future = session->join(parameters->realm()).then([&](boost::future<uint64_t> joined) {
+                    try {
+                        joined.get();
+                    } catch (const std::exception& e) {
+                        std::cerr << e.what() << std::endl;
+                        io.stop();
+                        return;
+                    }
+
+                    loop.call();
+                });
+            });
+        });
+
+        io.run();
+
+        if (loop.calls < warmup_calls + measured_calls) {
+            return 1;
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                loop.finished - loop.started);
+        std::cout << measured_calls << " calls, "
+                << double(loop.measured_allocations) / measured_calls << " allocations per call, "
+                << double(elapsed.count()) / measured_calls << "us per call" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}